@@ -17,6 +17,35 @@
 #include<thread>
 #include<functional>
 #include<cmath>
+#include<list>
+#include<condition_variable>
+#include<atomic>
+#include<array>
+#include<queue>
+#include<deque>
+#include<future>
+#include<shared_mutex>
+#include<climits>
+#include<cstdint>
+#include<cstring>
+#include<string_view>
+#include<charconv>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define BANKING_POSIX 1
+#include<fcntl.h>
+#include<poll.h>
+#include<sys/mman.h>
+#include<sys/stat.h>
+#include<unistd.h>
+#include<csignal>
+#include<sys/socket.h>
+#include<sys/un.h>
+#endif
+
+#ifdef __linux__
+#include<sys/inotify.h>
+#endif
 
 using namespace std;
 using namespace std::filesystem;
@@ -113,16 +142,45 @@ public:
         return time(nullptr);
     }
     
+    // gmtime_r: the async log writer formats timestamps alongside other threads
     static string formatTimestampUTC(time_t timestamp) {
-        struct tm* timeinfo = gmtime(&timestamp);
+        struct tm timeinfo;
+        gmtime_r(&timestamp, &timeinfo);
         char buffer[100];
-        strftime(buffer, sizeof(buffer), "%Y-%m-%d %H:%M:%S UTC", timeinfo);
+        strftime(buffer, sizeof(buffer), "%Y-%m-%d %H:%M:%S UTC", &timeinfo);
         return string(buffer);
     }
     
     static string getCurrentTimestampUTC() {
         return formatTimestampUTC(getCurrentUTC());
     }
+    
+    // Parses YYYY-MM-DD as midnight UTC. Returns false on malformed dates.
+    static bool parseDateUTC(const string& date, time_t& result) {
+        int year, month, day;
+        char dash1, dash2;
+        istringstream ss(date);
+        if (!(ss >> year >> dash1 >> month >> dash2 >> day) || dash1 != '-' || dash2 != '-' || !ss.eof()) {
+            return false;
+        }
+        static const int days_in_month[] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+        bool leap = (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+        if (year < 1970 || year > 9999 || month < 1 || month > 12 || day < 1 ||
+            day > days_in_month[month - 1] + ((month == 2 && leap) ? 1 : 0)) {
+            return false;
+        }
+        
+        // Days since 1970-01-01 (proleptic Gregorian, civil-from-days inverse)
+        int y = year - (month <= 2 ? 1 : 0);
+        int era = y / 400;
+        int year_of_era = y - era * 400;
+        int day_of_year = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+        int day_of_era = year_of_era * 365 + year_of_era / 4 - year_of_era / 100 + day_of_year;
+        long long days = static_cast<long long>(era) * 146097 + day_of_era - 719468;
+        
+        result = static_cast<time_t>(days * 86400);
+        return true;
+    }
 };
 
 // =============================================================================
@@ -138,7 +196,7 @@ string accountTypeToString(AccountType type) {
     }
 }
 
-AccountType stringToAccountType(const string& str) {
+AccountType stringToAccountType(string_view str) {
     if (str == "SAVINGS") return AccountType::SAVINGS;
     if (str == "CURRENT") return AccountType::CURRENT;
     if (str == "LOAN") return AccountType::LOAN;
@@ -163,7 +221,7 @@ string transactionTypeToString(TransactionType type) {
     }
 }
 
-TransactionType stringToTransactionType(const string& str) {
+TransactionType stringToTransactionType(string_view str) {
     if (str == "DEPOSIT") return TransactionType::DEPOSIT;
     if (str == "WITHDRAWAL") return TransactionType::WITHDRAWAL;
     if (str == "CREDIT") return TransactionType::CREDIT;
@@ -179,15 +237,483 @@ TransactionType stringToTransactionType(const string& str) {
     return TransactionType::DEPOSIT;
 }
 
+// =============================================================================
+// PER-THREAD METRIC SLOTS
+// =============================================================================
+//
+// Gives every thread its own Slot so hot-path instrumentation never writes a
+// cache line another thread is writing; readers sum over all slots. Slots are
+// never freed - a thread's slot is returned to the pool when it exits and
+// reused by the next new thread, so totals survive thread churn. The registry
+// is deliberately leaked because the logger can still record while static
+// objects are being destroyed.
+
+template<typename Slot>
+class PerThreadSlots {
+private:
+    struct Registry {
+        mutex registry_mutex;
+        vector<unique_ptr<Slot>> slots;
+        vector<bool> in_use;
+    };
+    
+    struct Lease {
+        Slot* slot = nullptr;
+        size_t index = 0;
+        
+        ~Lease() {
+            if (!slot) return;
+            Registry& reg = registry();
+            lock_guard<mutex> lock(reg.registry_mutex);
+            reg.in_use[index] = false;
+        }
+    };
+    
+    static Registry& registry() {
+        static Registry* instance = new Registry();
+        return *instance;
+    }
+    
+    static Slot& acquire() {
+        thread_local Lease lease;
+        Registry& reg = registry();
+        lock_guard<mutex> lock(reg.registry_mutex);
+        size_t index = 0;
+        while (index < reg.slots.size() && reg.in_use[index]) {
+            index++;
+        }
+        if (index == reg.slots.size()) {
+            reg.slots.push_back(make_unique<Slot>());  // value-initialised: every counter zero
+            reg.in_use.push_back(false);
+        }
+        reg.in_use[index] = true;
+        lease.slot = reg.slots[index].get();
+        lease.index = index;
+        return *lease.slot;
+    }
+    
+public:
+    static Slot& local() {
+        thread_local Slot* cached = nullptr;
+        if (!cached) {
+            cached = &acquire();
+        }
+        return *cached;
+    }
+    
+    template<typename Visitor>
+    static void forEach(Visitor visit) {
+        Registry& reg = registry();
+        lock_guard<mutex> lock(reg.registry_mutex);
+        for (const auto& slot : reg.slots) {
+            visit(static_cast<const Slot&>(*slot));
+        }
+    }
+    
+    // Single-writer increment: the owning thread is the only writer, so a
+    // relaxed load/store pair replaces a locked read-modify-write.
+    static void bump(atomic<uint64_t>& counter, uint64_t amount) {
+        counter.store(counter.load(memory_order_relaxed) + amount, memory_order_relaxed);
+    }
+};
+
+// =============================================================================
+// PER-OPERATION LATENCY HISTOGRAMS
+// =============================================================================
+//
+// Log-linear (HDR-style) buckets: values under 32 ns get a bucket each, and
+// every power of two above that is split into 16, so a recorded value is
+// within about 6% of its bucket bound over the whole 64-bit range. Each thread
+// records into its own PerThreadSlots block and readers merge every block.
+
+enum class LatencyMetric {
+    ACCOUNT_CREDIT,
+    ACCOUNT_DEBIT,
+    TRANSFER,
+    EMI_PAYMENT,
+    MONTHLY_INTEREST,
+    ATOMIC_SAVE,
+    LOGGER_LOG,
+    AUTH_CHECK,
+    COUNT
+};
+
+string latencyMetricToString(LatencyMetric metric) {
+    switch (metric) {
+        case LatencyMetric::ACCOUNT_CREDIT: return "account.credit";
+        case LatencyMetric::ACCOUNT_DEBIT: return "account.debit";
+        case LatencyMetric::TRANSFER: return "bank.transfer";
+        case LatencyMetric::EMI_PAYMENT: return "loan.emi_payment";
+        case LatencyMetric::MONTHLY_INTEREST: return "bank.monthly_interest";
+        case LatencyMetric::ATOMIC_SAVE: return "file.atomic_save";
+        case LatencyMetric::LOGGER_LOG: return "logger.log";
+        case LatencyMetric::AUTH_CHECK: return "auth.pin_check";
+        default: return "unknown";
+    }
+}
+
+class LatencyHistograms {
+public:
+    static constexpr size_t METRIC_COUNT = static_cast<size_t>(LatencyMetric::COUNT);
+    static constexpr uint64_t LINEAR_BUCKETS = 32;
+    static constexpr uint64_t SUB_BUCKETS = 16;
+    static constexpr size_t BUCKET_COUNT = LINEAR_BUCKETS + 59 * SUB_BUCKETS;  // covers 2^64 ns
+    
+    using Buckets = array<uint64_t, BUCKET_COUNT>;
+    
+    struct Summary {
+        uint64_t count = 0;
+        double mean_ns = 0.0;
+        uint64_t p50_ns = 0;
+        uint64_t p90_ns = 0;
+        uint64_t p99_ns = 0;
+        uint64_t p999_ns = 0;
+        uint64_t max_ns = 0;
+    };
+    
+private:
+    struct alignas(64) ThreadBlock {
+        array<array<atomic<uint64_t>, BUCKET_COUNT>, METRIC_COUNT> counts;
+        array<atomic<uint64_t>, METRIC_COUNT> total_ns;
+    };
+    using Blocks = PerThreadSlots<ThreadBlock>;
+    
+    static atomic<bool> enabled;
+    
+    static int highestBit(uint64_t value) {
+#if defined(__GNUC__) || defined(__clang__)
+        return 63 - __builtin_clzll(value);
+#else
+        int bit = 0;
+        while (value >>= 1) bit++;
+        return bit;
+#endif
+    }
+    
+    static uint64_t bucketUpperBound(size_t index) {
+        if (index < LINEAR_BUCKETS) return index;
+        uint64_t offset = index - LINEAR_BUCKETS;
+        int shift = static_cast<int>(offset / SUB_BUCKETS) + 1;
+        uint64_t top = offset % SUB_BUCKETS + SUB_BUCKETS;
+        return ((top + 1) << shift) - 1;
+    }
+    
+public:
+    static size_t bucketIndex(uint64_t value_ns) {
+        if (value_ns < LINEAR_BUCKETS) return static_cast<size_t>(value_ns);
+        int shift = highestBit(value_ns) - 4;
+        uint64_t top = value_ns >> shift;  // 16..31
+        return static_cast<size_t>(LINEAR_BUCKETS + (shift - 1) * SUB_BUCKETS + (top - SUB_BUCKETS));
+    }
+    
+    static void setEnabled(bool on) { enabled.store(on, memory_order_relaxed); }
+    static bool isEnabled() { return enabled.load(memory_order_relaxed); }
+    
+    static void record(LatencyMetric metric, uint64_t value_ns) {
+        ThreadBlock& block = Blocks::local();
+        size_t m = static_cast<size_t>(metric);
+        Blocks::bump(block.counts[m][bucketIndex(value_ns)], 1);
+        Blocks::bump(block.total_ns[m], value_ns);
+    }
+    
+    // Sums every thread's buckets for one metric.
+    static Buckets merge(LatencyMetric metric, uint64_t& total_ns) {
+        Buckets merged{};
+        total_ns = 0;
+        size_t m = static_cast<size_t>(metric);
+        Blocks::forEach([&merged, &total_ns, m](const ThreadBlock& block) {
+            for (size_t i = 0; i < BUCKET_COUNT; i++) {
+                merged[i] += block.counts[m][i].load(memory_order_relaxed);
+            }
+            total_ns += block.total_ns[m].load(memory_order_relaxed);
+        });
+        return merged;
+    }
+    
+    static Summary summarize(LatencyMetric metric) {
+        uint64_t total_ns = 0;
+        Buckets buckets = merge(metric, total_ns);
+        
+        Summary summary;
+        for (uint64_t count : buckets) summary.count += count;
+        if (summary.count == 0) return summary;
+        summary.mean_ns = static_cast<double>(total_ns) / summary.count;
+        
+        // Percentiles report the upper bound of the bucket holding that rank
+        const double fractions[] = {0.50, 0.90, 0.99, 0.999, 1.0};
+        uint64_t* targets[] = {&summary.p50_ns, &summary.p90_ns, &summary.p99_ns, &summary.p999_ns, &summary.max_ns};
+        size_t next = 0;
+        uint64_t seen = 0;
+        for (size_t i = 0; i < BUCKET_COUNT && next < 5; i++) {
+            seen += buckets[i];
+            while (next < 5 && buckets[i] > 0 && seen >= static_cast<uint64_t>(ceil(fractions[next] * summary.count))) {
+                *targets[next++] = bucketUpperBound(i);
+            }
+        }
+        return summary;
+    }
+    
+    static void printReport(ostream& out) {
+        out << left << setw(24) << "Operation" << right << setw(12) << "Count" << setw(12) << "Mean us"
+            << setw(12) << "p50 us" << setw(12) << "p90 us" << setw(12) << "p99 us" << setw(12) << "p99.9 us"
+            << setw(12) << "Max us" << "\n";
+        out << string(108, '-') << "\n";
+        for (size_t m = 0; m < METRIC_COUNT; m++) {
+            Summary s = summarize(static_cast<LatencyMetric>(m));
+            out << left << setw(24) << latencyMetricToString(static_cast<LatencyMetric>(m)) << right << setw(12) << s.count
+                << fixed << setprecision(2) << setw(12) << s.mean_ns / 1000.0 << setw(12) << s.p50_ns / 1000.0
+                << setw(12) << s.p90_ns / 1000.0 << setw(12) << s.p99_ns / 1000.0 << setw(12) << s.p999_ns / 1000.0
+                << setw(12) << s.max_ns / 1000.0 << "\n";
+        }
+    }
+    
+    // Writes the summary table followed by every non-empty bucket, as
+    // "<metric> <bucket upper bound ns> <count>" lines.
+    static bool dumpToFile(const string& filename) {
+        ofstream out(filename);
+        if (!out.is_open()) return false;
+        
+        out << "# Latency histograms written " << TimeUtils::getCurrentTimestampUTC() << "\n";
+        printReport(out);
+        out << "\n# metric upper_bound_ns count\n";
+        for (size_t m = 0; m < METRIC_COUNT; m++) {
+            uint64_t total_ns = 0;
+            Buckets buckets = merge(static_cast<LatencyMetric>(m), total_ns);
+            for (size_t i = 0; i < BUCKET_COUNT; i++) {
+                if (buckets[i] > 0) {
+                    out << latencyMetricToString(static_cast<LatencyMetric>(m)) << " " << bucketUpperBound(i) 
+                        << " " << buckets[i] << "\n";
+                }
+            }
+        }
+        return static_cast<bool>(out);
+    }
+};
+
+atomic<bool> LatencyHistograms::enabled(true);
+
+// Records the lifetime of the enclosing scope into one histogram.
+class ScopedLatency {
+private:
+    LatencyMetric metric;
+    bool active;
+    chrono::steady_clock::time_point start_time;
+    
+public:
+    explicit ScopedLatency(LatencyMetric latency_metric) 
+        : metric(latency_metric), active(LatencyHistograms::isEnabled()) {
+        if (active) start_time = chrono::steady_clock::now();
+    }
+    
+    ~ScopedLatency() {
+        if (active) {
+            LatencyHistograms::record(metric, static_cast<uint64_t>(
+                chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start_time).count()));
+        }
+    }
+    
+    ScopedLatency(const ScopedLatency&) = delete;
+    ScopedLatency& operator=(const ScopedLatency&) = delete;
+};
+
+// =============================================================================
+// PROCESS METRIC COUNTERS
+// =============================================================================
+//
+// Monotonic event counters for the metrics exporter, kept in cache-line
+// aligned PerThreadSlots so counting on the hot path is uncontended.
+
+enum class MetricCounter {
+    TRANSACTION_ROLLBACKS,
+    ATOMIC_SAVES,
+    ATOMIC_SAVE_NANOSECONDS,
+    PIN_LOCKOUTS,
+    COUNT
+};
+
+class MetricCounters {
+public:
+    static constexpr size_t COUNTER_COUNT = static_cast<size_t>(MetricCounter::COUNT);
+    static constexpr size_t TRANSACTION_TYPE_COUNT = static_cast<size_t>(TransactionType::ACCOUNT_CREATED) + 1;
+    
+private:
+    struct alignas(64) Slot {
+        array<atomic<uint64_t>, COUNTER_COUNT> counters;
+        array<atomic<uint64_t>, TRANSACTION_TYPE_COUNT> transactions;
+    };
+    using Slots = PerThreadSlots<Slot>;
+    
+public:
+    static void add(MetricCounter counter, uint64_t amount = 1) {
+        Slots::bump(Slots::local().counters[static_cast<size_t>(counter)], amount);
+    }
+    
+    static void countTransaction(TransactionType type) {
+        size_t index = static_cast<size_t>(type);
+        if (index < TRANSACTION_TYPE_COUNT) {
+            Slots::bump(Slots::local().transactions[index], 1);
+        }
+    }
+    
+    static uint64_t total(MetricCounter counter) {
+        uint64_t sum = 0;
+        size_t index = static_cast<size_t>(counter);
+        Slots::forEach([&sum, index](const Slot& slot) {
+            sum += slot.counters[index].load(memory_order_relaxed);
+        });
+        return sum;
+    }
+    
+    static array<uint64_t, TRANSACTION_TYPE_COUNT> transactionTotals() {
+        array<uint64_t, TRANSACTION_TYPE_COUNT> totals{};
+        Slots::forEach([&totals](const Slot& slot) {
+            for (size_t i = 0; i < TRANSACTION_TYPE_COUNT; i++) {
+                totals[i] += slot.transactions[i].load(memory_order_relaxed);
+            }
+        });
+        return totals;
+    }
+};
+
 // =============================================================================
 // CONFIGURATION MANAGER
 // =============================================================================
 
+// Immutable, typed view of the configuration. Built and validated once per
+// load or reload; hot paths read the typed fields instead of parsing strings.
+// Invalid values fall back to their defaults and are listed in warnings.
+struct ConfigSnapshot {
+    map<string, string> values;
+    unsigned long long generation = 0;
+    vector<string> warnings;
+    
+    string data_directory;
+    int min_account_number = 100001;
+    int max_account_number = 999999;
+    int pin_length = 4;
+    int max_pin_attempts = 3;
+    int min_password_length = 6;
+    long long min_amount_paise = 1;
+    long long max_amount_paise = 100000000;
+    int max_history_per_account = 500;
+    bool binary_accounts_format = false;
+    bool wal_enabled = true;
+    int wal_checkpoint_interval = 1000;
+    string durability_mode;
+    int group_commit_delay_us = 200;
+    string flush_policy;
+    int flush_interval_ms = 200;
+    int flush_bytes = 65536;
+    int max_open_files = 64;
+    int time_index_interval_bytes = 4096;
+};
+
 class ConfigManager {
 private:
     map<string, string> config_data;
+    map<string, string> runtime_overrides;
     string config_file_path;
     
+    // Readers load the current snapshot with a single atomic read and never
+    // lock. Snapshots are kept until the manager is destroyed, so a reader
+    // can hold a reference across a reload; reloads are rare and a snapshot
+    // is a few kilobytes.
+    atomic<const ConfigSnapshot*> current_snapshot;
+    vector<unique_ptr<ConfigSnapshot>> published_snapshots;
+    mutable mutex write_mutex;
+    
+    static long long parseSetting(const map<string, string>& values, const string& key, long long default_value,
+                                  long long min_value, long long max_value, vector<string>& warnings) {
+        auto it = values.find(key);
+        if (it == values.end()) return default_value;
+        try {
+            size_t consumed = 0;
+            long long value = stoll(it->second, &consumed);
+            if (consumed == it->second.size() && value >= min_value && value <= max_value) {
+                return value;
+            }
+        } catch (...) {
+        }
+        warnings.push_back(key + "=" + it->second + " is invalid; using " + to_string(default_value));
+        return default_value;
+    }
+    
+    static string parseChoice(const map<string, string>& values, const string& key, const string& default_value,
+                              const vector<string>& allowed, vector<string>& warnings) {
+        auto it = values.find(key);
+        if (it == values.end()) return default_value;
+        if (find(allowed.begin(), allowed.end(), it->second) != allowed.end()) {
+            return it->second;
+        }
+        warnings.push_back(key + "=" + it->second + " is invalid; using " + default_value);
+        return default_value;
+    }
+    
+    static unique_ptr<ConfigSnapshot> buildSnapshot(const map<string, string>& values) {
+        auto snapshot = make_unique<ConfigSnapshot>();
+        snapshot->values = values;
+        vector<string>& warnings = snapshot->warnings;
+        
+        auto data_it = values.find("directory.data");
+        snapshot->data_directory = (data_it != values.end() && !data_it->second.empty()) ? data_it->second : "data";
+        
+        snapshot->min_account_number = static_cast<int>(parseSetting(values, "account.min_account_number", 100001, 1, INT_MAX, warnings));
+        snapshot->max_account_number = static_cast<int>(parseSetting(values, "account.max_account_number", 999999, 1, INT_MAX, warnings));
+        if (snapshot->max_account_number < snapshot->min_account_number) {
+            warnings.push_back("account.max_account_number is below account.min_account_number; using defaults");
+            snapshot->min_account_number = 100001;
+            snapshot->max_account_number = 999999;
+        }
+        
+        snapshot->pin_length = static_cast<int>(parseSetting(values, "security.pin_length", 4, 4, 12, warnings));
+        snapshot->max_pin_attempts = static_cast<int>(parseSetting(values, "security.max_pin_attempts", 3, 1, 100, warnings));
+        snapshot->min_password_length = static_cast<int>(parseSetting(values, "security.min_password_length", 6, 1, 1024, warnings));
+        
+        snapshot->min_amount_paise = parseSetting(values, "amount.min_amount_paise", 1, 1, LLONG_MAX, warnings);
+        snapshot->max_amount_paise = parseSetting(values, "amount.max_amount_paise", 100000000, 1, LLONG_MAX, warnings);
+        if (snapshot->max_amount_paise < snapshot->min_amount_paise) {
+            warnings.push_back("amount.max_amount_paise is below amount.min_amount_paise; using defaults");
+            snapshot->min_amount_paise = 1;
+            snapshot->max_amount_paise = 100000000;
+        }
+        
+        snapshot->max_history_per_account = static_cast<int>(parseSetting(values, "transaction.max_history_per_account", 500, 1, 1000000, warnings));
+        snapshot->binary_accounts_format = parseChoice(values, "file.accounts_format", "text", {"text", "binary"}, warnings) == "binary";
+        snapshot->wal_enabled = parseSetting(values, "wal.enabled", 1, 0, 1, warnings) != 0;
+        snapshot->wal_checkpoint_interval = static_cast<int>(parseSetting(values, "wal.checkpoint_interval", 1000, 1, INT_MAX, warnings));
+        snapshot->durability_mode = parseChoice(values, "durability.mode", "group_commit", 
+                                                {"none", "per_commit", "group_commit"}, warnings);
+        snapshot->group_commit_delay_us = static_cast<int>(parseSetting(values, "durability.group_commit_delay_us", 200, 0, 1000000, warnings));
+        snapshot->flush_policy = parseChoice(values, "transaction_log.flush_policy", "per_commit", 
+                                             {"per_commit", "time", "size"}, warnings);
+        snapshot->flush_interval_ms = static_cast<int>(parseSetting(values, "transaction_log.flush_interval_ms", 200, 1, INT_MAX, warnings));
+        snapshot->flush_bytes = static_cast<int>(parseSetting(values, "transaction_log.flush_bytes", 65536, 1, INT_MAX, warnings));
+        snapshot->max_open_files = static_cast<int>(parseSetting(values, "transaction_log.max_open_files", 64, 1, INT_MAX, warnings));
+        snapshot->time_index_interval_bytes = static_cast<int>(parseSetting(values, "transaction_log.time_index_interval_bytes", 4096, 1, INT_MAX, warnings));
+        return snapshot;
+    }
+    
+    // Where and how the bank persists. The in-memory store, WAL and open
+    // transaction files belong to the values read at startup, so a reload
+    // keeps these and asks for a restart instead.
+    static const vector<string>& restartOnlyKeys() {
+        static const vector<string> keys = {"directory.data", "file.accounts_format", "wal.enabled", "durability.mode"};
+        return keys;
+    }
+    
+    // Caller holds write_mutex.
+    void publish(const vector<string>& extra_warnings = {}) {
+        map<string, string> values = config_data;
+        for (const auto& pair : runtime_overrides) {
+            values[pair.first] = pair.second;
+        }
+        unique_ptr<ConfigSnapshot> snapshot = buildSnapshot(values);
+        snapshot->warnings.insert(snapshot->warnings.end(), extra_warnings.begin(), extra_warnings.end());
+        snapshot->generation = published_snapshots.size() + 1;
+        current_snapshot.store(snapshot.get(), memory_order_release);
+        published_snapshots.push_back(move(snapshot));
+    }
+    
     void setDefaults() {
         config_data["account.min_account_number"] = "100001";
         config_data["account.max_account_number"] = "999999";
@@ -196,30 +722,96 @@ private:
         config_data["security.pin_length"] = "4";
         config_data["security.min_password_length"] = "6";
         config_data["security.salt_length"] = "16";
+        config_data["security.kdf_iterations"] = "50000";
+        config_data["security.auth_threads"] = "2";
         config_data["savings.min_interest_rate"] = "0.1";
         config_data["savings.max_interest_rate"] = "15.0";
+        config_data["savings.interest_threads"] = "0";
         config_data["loan.min_interest_rate"] = "1.0";
         config_data["loan.max_interest_rate"] = "20.0";
         config_data["loan.min_tenure_months"] = "6";
         config_data["loan.max_tenure_months"] = "360";
         config_data["transaction.max_history_per_account"] = "500";
+        config_data["transaction.node_id"] = "0";
         config_data["transaction.large_transaction_threshold"] = "50000";
         config_data["file.cleanup_days"] = "90";
         config_data["file.backup_retention_days"] = "30";
+        config_data["file.accounts_format"] = "text";
+        config_data["file.parse_threads"] = "0";
         config_data["directory.data"] = "data";
+        config_data["startup.threads"] = "0";
+        config_data["startup.preload_history"] = "0";
         config_data["directory.logs"] = "logs";
         config_data["directory.backups"] = "backups";
         config_data["directory.config"] = "config";
         config_data["amount.min_amount_paise"] = "1";
         config_data["amount.max_amount_paise"] = "100000000";
+        config_data["wal.enabled"] = "1";
+        config_data["wal.checkpoint_interval"] = "1000";
+        config_data["durability.mode"] = "group_commit";
+        config_data["durability.group_commit_delay_us"] = "200";
+        config_data["transaction_log.flush_policy"] = "per_commit";
+        config_data["transaction_log.flush_interval_ms"] = "200";
+        config_data["transaction_log.flush_bytes"] = "65536";
+        config_data["transaction_log.max_open_files"] = "64";
+        config_data["transaction_log.time_index_interval_bytes"] = "4096";
+        config_data["logging.async"] = "1";
+        config_data["logging.queue_capacity"] = "8192";
+        config_data["logging.overflow_policy"] = "drop_debug";
+        config_data["config.hot_reload"] = "1";
+        config_data["config.reload_poll_ms"] = "1000";
+        config_data["daemon.socket_path"] = "";
+        config_data["daemon.worker_threads"] = "0";
+        config_data["daemon.max_connections"] = "256";
+        config_data["metrics.latency_histograms"] = "1";
+        config_data["metrics.textfile_path"] = "";
+        config_data["metrics.textfile_interval_ms"] = "15000";
     }
     
 public:
-    ConfigManager(const string& config_file = "config/banking.ini") : config_file_path(config_file) {
+    ConfigManager(const string& config_file = "config/banking.ini") 
+        : config_file_path(config_file), current_snapshot(nullptr) {
+        lock_guard<mutex> lock(write_mutex);
+        setDefaults();
+        loadConfig();
+        publish();
+    }
+    
+    ConfigManager(const ConfigManager&) = delete;
+    ConfigManager& operator=(const ConfigManager&) = delete;
+    
+    const ConfigSnapshot& snapshot() const {
+        return *current_snapshot.load(memory_order_acquire);
+    }
+    
+    const string& getConfigFilePath() const { return config_file_path; }
+    
+    // Re-reads banking.ini and publishes a new snapshot. Runtime overrides are
+    // re-applied on top; changes to restart-only keys are ignored with a
+    // warning. Returns false if the file could not be read.
+    bool reload() {
+        lock_guard<mutex> lock(write_mutex);
+        if (!exists(config_file_path)) {
+            return false;
+        }
+        map<string, string> previous = config_data;
+        config_data.clear();
         setDefaults();
         loadConfig();
+        
+        vector<string> pinned;
+        for (const string& key : restartOnlyKeys()) {
+            if (config_data[key] != previous[key]) {
+                pinned.push_back(key + "=" + config_data[key] + " needs a restart; keeping " + previous[key]);
+                config_data[key] = previous[key];
+            }
+        }
+        publish(pinned);
+        return true;
     }
     
+private:
+    // Caller holds write_mutex.
     void loadConfig() {
         ifstream file(config_file_path);
         if (!file.is_open()) {
@@ -248,6 +840,7 @@ public:
         file.close();
     }
     
+    // Caller holds write_mutex.
     void saveConfig() {
         create_directories(path(config_file_path).parent_path());
         ofstream file(config_file_path);
@@ -265,11 +858,17 @@ public:
         file << "security.max_pin_attempts=" << config_data["security.max_pin_attempts"] << "\n";
         file << "security.pin_length=" << config_data["security.pin_length"] << "\n";
         file << "security.min_password_length=" << config_data["security.min_password_length"] << "\n";
-        file << "security.salt_length=" << config_data["security.salt_length"] << "\n\n";
+        file << "security.salt_length=" << config_data["security.salt_length"] << "\n";
+        file << "# kdf_iterations: PBKDF2-HMAC-SHA256 cost for new hashes; weaker stored hashes upgrade on next login\n";
+        file << "security.kdf_iterations=" << config_data["security.kdf_iterations"] << "\n";
+        file << "# auth_threads: workers running PIN/password checks (0 = one per core)\n";
+        file << "security.auth_threads=" << config_data["security.auth_threads"] << "\n\n";
         
         file << "[Banking Rules]\n";
         file << "savings.min_interest_rate=" << config_data["savings.min_interest_rate"] << "\n";
         file << "savings.max_interest_rate=" << config_data["savings.max_interest_rate"] << "\n";
+        file << "# interest_threads: 0 = one per hardware core\n";
+        file << "savings.interest_threads=" << config_data["savings.interest_threads"] << "\n";
         file << "loan.min_interest_rate=" << config_data["loan.min_interest_rate"] << "\n";
         file << "loan.max_interest_rate=" << config_data["loan.max_interest_rate"] << "\n";
         file << "loan.min_tenure_months=" << config_data["loan.min_tenure_months"] << "\n";
@@ -277,11 +876,16 @@ public:
         
         file << "[Transaction Settings]\n";
         file << "transaction.max_history_per_account=" << config_data["transaction.max_history_per_account"] << "\n";
+        file << "# node_id: 0-63, must differ between instances sharing a data set\n";
+        file << "transaction.node_id=" << config_data["transaction.node_id"] << "\n";
         file << "transaction.large_transaction_threshold=" << config_data["transaction.large_transaction_threshold"] << "\n\n";
         
         file << "[File Management]\n";
         file << "file.cleanup_days=" << config_data["file.cleanup_days"] << "\n";
-        file << "file.backup_retention_days=" << config_data["file.backup_retention_days"] << "\n\n";
+        file << "file.backup_retention_days=" << config_data["file.backup_retention_days"] << "\n";
+        file << "file.accounts_format=" << config_data["file.accounts_format"] << "\n";
+        file << "# parse_threads: 0 = one per hardware core (files under 1 MiB always parse on one thread)\n";
+        file << "file.parse_threads=" << config_data["file.parse_threads"] << "\n\n";
         
         file << "[Directory Structure]\n";
         file << "directory.data=" << config_data["directory.data"] << "\n";
@@ -289,21 +893,72 @@ public:
         file << "directory.backups=" << config_data["directory.backups"] << "\n";
         file << "directory.config=" << config_data["directory.config"] << "\n\n";
         
+        file << "[Startup]\n";
+        file << "# threads: 0 = one per hardware core\n";
+        file << "startup.threads=" << config_data["startup.threads"] << "\n";
+        file << "# preload_history: 1 = load every account's history at startup instead of on first use\n";
+        file << "startup.preload_history=" << config_data["startup.preload_history"] << "\n\n";
+        
         file << "[Amount Limits]\n";
         file << "amount.min_amount_paise=" << config_data["amount.min_amount_paise"] << "\n";
-        file << "amount.max_amount_paise=" << config_data["amount.max_amount_paise"] << "\n";
+        file << "amount.max_amount_paise=" << config_data["amount.max_amount_paise"] << "\n\n";
+        
+        file << "[Write-Ahead Log]\n";
+        file << "wal.enabled=" << config_data["wal.enabled"] << "\n";
+        file << "wal.checkpoint_interval=" << config_data["wal.checkpoint_interval"] << "\n\n";
+        
+        file << "[Durability]\n";
+        file << "# mode: none | per_commit | group_commit\n";
+        file << "durability.mode=" << config_data["durability.mode"] << "\n";
+        file << "durability.group_commit_delay_us=" << config_data["durability.group_commit_delay_us"] << "\n\n";
+        
+        file << "[Transaction Log Appender]\n";
+        file << "# flush_policy: per_commit | time | size\n";
+        file << "transaction_log.flush_policy=" << config_data["transaction_log.flush_policy"] << "\n";
+        file << "transaction_log.flush_interval_ms=" << config_data["transaction_log.flush_interval_ms"] << "\n";
+        file << "transaction_log.flush_bytes=" << config_data["transaction_log.flush_bytes"] << "\n";
+        file << "transaction_log.max_open_files=" << config_data["transaction_log.max_open_files"] << "\n";
+        file << "transaction_log.time_index_interval_bytes=" << config_data["transaction_log.time_index_interval_bytes"] << "\n\n";
+        
+        file << "[Configuration]\n";
+        file << "# hot_reload: watch this file (inotify on Linux, polling elsewhere) and apply edits live\n";
+        file << "config.hot_reload=" << config_data["config.hot_reload"] << "\n";
+        file << "config.reload_poll_ms=" << config_data["config.reload_poll_ms"] << "\n\n";
+        
+        file << "[Daemon]\n";
+        file << "# socket_path: empty = <data directory>/banking.sock; worker_threads: 0 = one per hardware core\n";
+        file << "daemon.socket_path=" << config_data["daemon.socket_path"] << "\n";
+        file << "daemon.worker_threads=" << config_data["daemon.worker_threads"] << "\n";
+        file << "daemon.max_connections=" << config_data["daemon.max_connections"] << "\n\n";
+        
+        file << "[Metrics]\n";
+        file << "# latency_histograms: record per-operation latency (admin menu option 7)\n";
+        file << "metrics.latency_histograms=" << config_data["metrics.latency_histograms"] << "\n";
+        file << "# textfile_path: Prometheus textfile output, empty = <logs directory>/banking.prom; interval 0 = off\n";
+        file << "metrics.textfile_path=" << config_data["metrics.textfile_path"] << "\n";
+        file << "metrics.textfile_interval_ms=" << config_data["metrics.textfile_interval_ms"] << "\n\n";
+        
+        file << "[Logging]\n";
+        file << "# overflow_policy: block | drop_debug | drop_oldest\n";
+        file << "logging.async=" << config_data["logging.async"] << "\n";
+        file << "logging.queue_capacity=" << config_data["logging.queue_capacity"] << "\n";
+        file << "logging.overflow_policy=" << config_data["logging.overflow_policy"] << "\n";
         
         file.close();
     }
     
+public:
+    // Untyped lookups for cold paths; hot paths use snapshot().
     string getString(const string& key, const string& default_value = "") const {
-        auto it = config_data.find(key);
-        return (it != config_data.end()) ? it->second : default_value;
+        const map<string, string>& values = snapshot().values;
+        auto it = values.find(key);
+        return (it != values.end()) ? it->second : default_value;
     }
     
     int getInt(const string& key, int default_value = 0) const {
-        auto it = config_data.find(key);
-        if (it != config_data.end()) {
+        const map<string, string>& values = snapshot().values;
+        auto it = values.find(key);
+        if (it != values.end()) {
             try {
                 return stoi(it->second);
             } catch (...) {
@@ -314,8 +969,9 @@ public:
     }
     
     long long getLongLong(const string& key, long long default_value = 0) const {
-        auto it = config_data.find(key);
-        if (it != config_data.end()) {
+        const map<string, string>& values = snapshot().values;
+        auto it = values.find(key);
+        if (it != values.end()) {
             try {
                 return stoll(it->second);
             } catch (...) {
@@ -326,8 +982,9 @@ public:
     }
     
     float getFloat(const string& key, float default_value = 0.0f) const {
-        auto it = config_data.find(key);
-        if (it != config_data.end()) {
+        const map<string, string>& values = snapshot().values;
+        auto it = values.find(key);
+        if (it != values.end()) {
             try {
                 return stof(it->second);
             } catch (...) {
@@ -338,8 +995,18 @@ public:
     }
     
     void setValue(const string& key, const string& value) {
+        lock_guard<mutex> lock(write_mutex);
         config_data[key] = value;
         saveConfig();
+        publish();
+    }
+    
+    // Overrides a value for this process only; banking.ini is left untouched
+    // and the override survives hot reloads.
+    void setRuntimeValue(const string& key, const string& value) {
+        lock_guard<mutex> lock(write_mutex);
+        runtime_overrides[key] = value;
+        publish();
     }
 };
 
@@ -347,16 +1014,124 @@ public:
 // THREAD-SAFE PROFESSIONAL LOGGING SYSTEM WITH UTC
 // =============================================================================
 
+enum class LogOverflowPolicy {
+    BLOCK,
+    DROP_DEBUG,
+    DROP_OLDEST
+};
+
+struct LogRecord {
+    LogLevel level;
+    time_t timestamp_utc;
+    string message;
+};
+
+// Bounded lock-free ring buffer (Vyukov sequence-per-cell design). Many
+// producers push; the logger's writer thread pops. Pop is also safe from
+// producers, which the DROP_OLDEST overflow policy relies on.
+class LogRingBuffer {
+private:
+    struct Cell {
+        atomic<size_t> sequence;
+        LogRecord record;
+    };
+    
+    unique_ptr<Cell[]> cells;
+    size_t mask;
+    alignas(64) atomic<size_t> enqueue_pos;
+    alignas(64) atomic<size_t> dequeue_pos;
+    
+public:
+    explicit LogRingBuffer(size_t requested_capacity) : enqueue_pos(0), dequeue_pos(0) {
+        size_t capacity = 2;
+        while (capacity < requested_capacity) {
+            capacity <<= 1;
+        }
+        cells.reset(new Cell[capacity]);
+        for (size_t i = 0; i < capacity; i++) {
+            cells[i].sequence.store(i, memory_order_relaxed);
+        }
+        mask = capacity - 1;
+    }
+    
+    // Moves from record only on success.
+    bool tryPush(LogRecord& record) {
+        size_t pos = enqueue_pos.load(memory_order_relaxed);
+        while (true) {
+            Cell& cell = cells[pos & mask];
+            size_t sequence = cell.sequence.load(memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+            if (diff == 0) {
+                if (enqueue_pos.compare_exchange_weak(pos, pos + 1, memory_order_relaxed)) {
+                    cell.record = move(record);
+                    cell.sequence.store(pos + 1, memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = enqueue_pos.load(memory_order_relaxed);
+            }
+        }
+    }
+    
+    bool tryPop(LogRecord& record) {
+        size_t pos = dequeue_pos.load(memory_order_relaxed);
+        while (true) {
+            Cell& cell = cells[pos & mask];
+            size_t sequence = cell.sequence.load(memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos + 1);
+            if (diff == 0) {
+                if (dequeue_pos.compare_exchange_weak(pos, pos + 1, memory_order_relaxed)) {
+                    record = move(cell.record);
+                    cell.sequence.store(pos + mask + 1, memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = dequeue_pos.load(memory_order_relaxed);
+            }
+        }
+    }
+    
+    size_t approximateSize() const {
+        size_t head = dequeue_pos.load(memory_order_relaxed);
+        size_t tail = enqueue_pos.load(memory_order_relaxed);
+        return tail > head ? tail - head : 0;
+    }
+    
+    size_t capacity() const { return mask + 1; }
+};
+
 class Logger {
 private:
     static Logger* instance;
+    static once_flag init_flag;
     static mutex log_mutex;
     ofstream log_file;
     LogLevel min_level;
-    bool console_output;
+    atomic<bool> console_output;
     string log_directory;
     
-    Logger() : min_level(LogLevel::INFO), console_output(true) {
+    // Asynchronous backend
+    unique_ptr<LogRingBuffer> ring;
+    thread writer_thread;
+    atomic<bool> async_running;
+    atomic<bool> stop_writer;
+    atomic<bool> writer_sleeping;
+    // Producers between their async_running check and the end of their push;
+    // shutdown waits for these so no record lands after the final drain.
+    atomic<int> pushes_in_flight;
+    atomic<unsigned long long> dropped_records;
+    LogOverflowPolicy overflow_policy;
+    mutex wake_mutex;
+    condition_variable wake_cv;
+    
+    static constexpr size_t WRITER_BATCH_SIZE = 256;
+    
+    Logger() : min_level(LogLevel::INFO), console_output(true), async_running(false), stop_writer(false),
+               writer_sleeping(false), pushes_in_flight(0), dropped_records(0), overflow_policy(LogOverflowPolicy::DROP_DEBUG) {
         log_directory = "logs";
         create_directories(log_directory);
         
@@ -379,20 +1154,177 @@ private:
         }
     }
     
+    void writeBatch(const string& batch) {
+        lock_guard<mutex> guard(log_mutex);
+        if (log_file.is_open()) {
+            log_file.write(batch.data(), batch.size());
+            log_file.flush();
+        }
+        if (console_output) {
+            cout.write(batch.data(), batch.size());
+            cout.flush();
+        }
+    }
+    
+    // Drains up to one batch into a single buffer and writes it. Returns the
+    // number of records written.
+    size_t drainBatch(string& batch, time_t& cached_second, string& cached_timestamp) {
+        batch.clear();
+        size_t count = 0;
+        LogRecord record;
+        while (count < WRITER_BATCH_SIZE && ring->tryPop(record)) {
+            if (record.timestamp_utc != cached_second) {
+                cached_second = record.timestamp_utc;
+                cached_timestamp = TimeUtils::formatTimestampUTC(cached_second);
+            }
+            batch += "[";
+            batch += cached_timestamp;
+            batch += "] [";
+            batch += levelToString(record.level);
+            batch += "] ";
+            batch += record.message;
+            batch += '\n';
+            count++;
+        }
+        if (count > 0) {
+            writeBatch(batch);
+        }
+        return count;
+    }
+    
+    void writerLoop() {
+        string batch;
+        time_t cached_second = 0;
+        string cached_timestamp;
+        
+        while (true) {
+            if (drainBatch(batch, cached_second, cached_timestamp) > 0) {
+                continue;
+            }
+            if (stop_writer.load(memory_order_acquire)) {
+                break;
+            }
+            
+            writer_sleeping.store(true, memory_order_release);
+            {
+                unique_lock<mutex> lock(wake_mutex);
+                wake_cv.wait_for(lock, chrono::milliseconds(10), [this]() {
+                    return stop_writer.load(memory_order_acquire) || ring->approximateSize() > 0;
+                });
+            }
+            writer_sleeping.store(false, memory_order_release);
+        }
+        
+        while (drainBatch(batch, cached_second, cached_timestamp) > 0) {}
+    }
+    
+    void wakeWriter() {
+        if (writer_sleeping.load(memory_order_acquire)) {
+            wake_cv.notify_one();
+        }
+    }
+    
+    void enqueue(LogLevel level, const string& message) {
+        LogRecord record{level, TimeUtils::getCurrentUTC(), message};
+        
+        while (!ring->tryPush(record)) {
+            if (overflow_policy == LogOverflowPolicy::DROP_OLDEST) {
+                LogRecord discarded;
+                if (ring->tryPop(discarded)) {
+                    dropped_records.fetch_add(1, memory_order_relaxed);
+                }
+                continue;
+            }
+            if (overflow_policy == LogOverflowPolicy::DROP_DEBUG && level == LogLevel::DEBUG) {
+                dropped_records.fetch_add(1, memory_order_relaxed);
+                return;
+            }
+            wakeWriter();
+            this_thread::yield();
+        }
+        
+        wakeWriter();
+    }
+    
 public:
     static Logger& getInstance() {
-        lock_guard<mutex> guard(log_mutex);
-        if (!instance) {
+        call_once(init_flag, []() {
             instance = new Logger();
-        }
+        });
         return *instance;
     }
     
+    static LogOverflowPolicy parseOverflowPolicy(const string& policy) {
+        if (policy == "block") return LogOverflowPolicy::BLOCK;
+        if (policy == "drop_oldest") return LogOverflowPolicy::DROP_OLDEST;
+        return LogOverflowPolicy::DROP_DEBUG;
+    }
+    
     void setLevel(LogLevel level) { min_level = level; }
     void setConsoleOutput(bool enable) { console_output = enable; }
     
+    // Switches to the asynchronous backend: callers only push into the ring
+    // buffer and a background thread writes batches.
+    void startAsync(size_t queue_capacity, LogOverflowPolicy policy) {
+        lock_guard<mutex> guard(log_mutex);
+        if (async_running.load()) return;
+        
+        overflow_policy = policy;
+        ring = make_unique<LogRingBuffer>(max<size_t>(queue_capacity, 2));
+        stop_writer.store(false);
+        writer_thread = thread(&Logger::writerLoop, this);
+        async_running.store(true, memory_order_release);
+        
+        static bool shutdown_registered = false;
+        if (!shutdown_registered) {
+            shutdown_registered = true;
+            atexit([]() { Logger::getInstance().shutdown(); });
+        }
+    }
+    
+    // Drains pending records and returns to synchronous logging.
+    void shutdown() {
+        if (!async_running.exchange(false)) return;
+        
+        stop_writer.store(true, memory_order_release);
+        wake_cv.notify_one();
+        if (writer_thread.joinable()) {
+            writer_thread.join();
+        }
+        
+        // Producers that saw async_running just before the exchange may still
+        // be pushing; keep draining (a blocked producer needs the space) until
+        // they are done, then pick up their records.
+        string batch;
+        time_t cached_second = 0;
+        string cached_timestamp;
+        while (pushes_in_flight.load() > 0) {
+            if (drainBatch(batch, cached_second, cached_timestamp) == 0) {
+                this_thread::yield();
+            }
+        }
+        while (drainBatch(batch, cached_second, cached_timestamp) > 0) {}
+    }
+    
+    bool isAsync() const { return async_running.load(memory_order_acquire); }
+    unsigned long long getDroppedCount() const { return dropped_records.load(memory_order_relaxed); }
+    size_t getQueueDepth() const { return ring ? ring->approximateSize() : 0; }
+    
     void log(LogLevel level, const string& message) {
         if (level < min_level) return;
+        ScopedLatency latency(LatencyMetric::LOGGER_LOG);
+        
+        if (async_running.load(memory_order_acquire)) {
+            pushes_in_flight.fetch_add(1);
+            // Re-checked after registering, so shutdown either waits for this
+            // push or the record takes the synchronous path below
+            if (async_running.load()) {
+                enqueue(level, message);
+                pushes_in_flight.fetch_sub(1);
+                return;
+            }
+            pushes_in_flight.fetch_sub(1);
+        }
         
         lock_guard<mutex> guard(log_mutex);
         
@@ -414,6 +1346,7 @@ public:
     void error(const string& message) { log(LogLevel::ERROR, message); }
     
     ~Logger() {
+        shutdown();
         if (log_file.is_open()) {
             log_file.close();
         }
@@ -421,8 +1354,133 @@ public:
 };
 
 Logger* Logger::instance = nullptr;
+once_flag Logger::init_flag;
 mutex Logger::log_mutex;
 
+// =============================================================================
+// CONFIGURATION HOT RELOAD
+// =============================================================================
+//
+// Watches banking.ini and publishes a fresh ConfigSnapshot whenever it is
+// saved. On Linux the containing directory is watched with inotify, which
+// also catches editors that save by writing a new file and renaming it;
+// elsewhere, or if inotify is unavailable, the modification time is polled
+// every config.reload_poll_ms. Settings consumed once at startup (thread
+// counts, logging queue) still need a restart, and the persistence settings
+// (data directory, accounts format, WAL, durability) keep their startup
+// values until one.
+
+class ConfigWatcher {
+private:
+    ConfigManager& config;
+    atomic<bool> running;
+    thread watcher_thread;
+    mutex stop_mutex;
+    condition_variable stop_cv;
+    
+    void applyReload() {
+        if (!config.reload()) {
+            Logger::getInstance().warning("Configuration reload failed: " + config.getConfigFilePath() + " unreadable");
+            return;
+        }
+        const ConfigSnapshot& snapshot = config.snapshot();
+        for (const auto& warning : snapshot.warnings) {
+            Logger::getInstance().warning("Configuration: " + warning);
+        }
+        Logger::getInstance().info("Configuration reloaded from " + config.getConfigFilePath() + 
+                                  " (generation " + to_string(snapshot.generation) + ")");
+    }
+    
+    void pollLoop() {
+        int interval_ms = max(50, config.getInt("config.reload_poll_ms", 1000));
+        error_code ec;
+        file_time_type last_write = last_write_time(config.getConfigFilePath(), ec);
+        
+        while (running.load()) {
+            {
+                unique_lock<mutex> lock(stop_mutex);
+                if (stop_cv.wait_for(lock, chrono::milliseconds(interval_ms), [this]() { return !running.load(); })) {
+                    break;
+                }
+            }
+            file_time_type current_write = last_write_time(config.getConfigFilePath(), ec);
+            if (!ec && current_write != last_write) {
+                last_write = current_write;
+                applyReload();
+            }
+        }
+    }
+    
+#ifdef __linux__
+    // Returns false if inotify cannot be used, so the caller can poll instead.
+    bool inotifyLoop() {
+        int fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if (fd < 0) return false;
+        
+        path config_path(config.getConfigFilePath());
+        string directory = config_path.parent_path().empty() ? "." : config_path.parent_path().string();
+        string filename = config_path.filename().string();
+        if (inotify_add_watch(fd, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO) < 0) {
+            ::close(fd);
+            return false;
+        }
+        
+        alignas(inotify_event) char buffer[4096];
+        while (running.load()) {
+            pollfd watch_fd = {fd, POLLIN, 0};
+            if (poll(&watch_fd, 1, 250) <= 0) continue;
+            
+            bool changed = false;
+            ssize_t length;
+            while ((length = read(fd, buffer, sizeof(buffer))) > 0) {
+                for (char* cursor = buffer; cursor < buffer + length; ) {
+                    const inotify_event* event = reinterpret_cast<const inotify_event*>(cursor);
+                    if (event->len > 0 && filename == event->name) {
+                        changed = true;
+                    }
+                    cursor += sizeof(inotify_event) + event->len;
+                }
+            }
+            if (changed) {
+                applyReload();
+            }
+        }
+        ::close(fd);
+        return true;
+    }
+#endif
+    
+public:
+    ConfigWatcher(ConfigManager& cfg) : config(cfg), running(false) {}
+    
+    ~ConfigWatcher() {
+        stop();
+    }
+    
+    void start() {
+        if (running.exchange(true)) return;
+        watcher_thread = thread([this]() {
+#ifdef __linux__
+            if (inotifyLoop()) return;
+            Logger::getInstance().warning("inotify unavailable - polling configuration file instead");
+#endif
+            pollLoop();
+        });
+        Logger::getInstance().info("Watching " + config.getConfigFilePath() + " for configuration changes");
+    }
+    
+    void stop() {
+        {
+            lock_guard<mutex> lock(stop_mutex);
+            if (!running.exchange(false)) return;
+        }
+        stop_cv.notify_all();
+        if (watcher_thread.joinable()) {
+            watcher_thread.join();
+        }
+    }
+};
+
 // =============================================================================
 // CUSTOM EXCEPTION CLASSES
 // =============================================================================
@@ -467,6 +1525,360 @@ public:
     TransactionException(const string& msg) : BankingException("Transaction Error: " + msg) {}
 };
 
+// =============================================================================
+// TRANSACTION RESULT CODES
+// =============================================================================
+//
+// Declines such as insufficient funds or an out-of-limit amount are routine
+// outcomes, not faults. The try* operations report them as a TxnStatus with
+// nothing changed and nothing logged, so a burst of declines costs no
+// allocation, unwind or error-log write. The throwing operations wrap them for
+// callers that prefer exceptions; real faults (I/O, corruption, overflow)
+// still throw.
+
+enum class TxnStatus {
+    OK,
+    INSUFFICIENT_FUNDS,
+    INVALID_AMOUNT,
+    ACCOUNT_NOT_FOUND,
+    SAME_ACCOUNT,
+    NOT_PERMITTED,
+    LOAN_CLOSED
+};
+
+struct TxnResult {
+    TxnStatus status;
+    long long amount_paise;  // amount actually applied; EMI payments may be capped
+    
+    TxnResult(TxnStatus result_status = TxnStatus::OK, long long applied_paise = 0) 
+        : status(result_status), amount_paise(applied_paise) {}
+    
+    bool ok() const { return status == TxnStatus::OK; }
+};
+
+string txnStatusToString(TxnStatus status) {
+    switch (status) {
+        case TxnStatus::OK: return "OK";
+        case TxnStatus::INSUFFICIENT_FUNDS: return "INSUFFICIENT_FUNDS";
+        case TxnStatus::INVALID_AMOUNT: return "INVALID_AMOUNT";
+        case TxnStatus::ACCOUNT_NOT_FOUND: return "ACCOUNT_NOT_FOUND";
+        case TxnStatus::SAME_ACCOUNT: return "SAME_ACCOUNT";
+        case TxnStatus::NOT_PERMITTED: return "NOT_PERMITTED";
+        case TxnStatus::LOAN_CLOSED: return "LOAN_CLOSED";
+        default: return "UNKNOWN";
+    }
+}
+
+// Converts a decline into the exception the throwing API has always raised.
+[[noreturn]] void throwTxnStatus(TxnStatus status, const string& detail) {
+    switch (status) {
+        case TxnStatus::INSUFFICIENT_FUNDS: throw InsufficientFundsException(detail);
+        case TxnStatus::INVALID_AMOUNT: throw InvalidAmountException(detail);
+        case TxnStatus::ACCOUNT_NOT_FOUND: throw AccountNotFoundException(detail);
+        default: throw TransactionException(detail);
+    }
+}
+
+// =============================================================================
+// FIXED-SIZE THREAD POOL
+// =============================================================================
+
+class ThreadPool {
+private:
+    vector<thread> workers;
+    queue<function<void()>> tasks;
+    mutex queue_mutex;
+    condition_variable task_available;
+    bool stopping;
+    
+    void workerLoop() {
+        while (true) {
+            function<void()> task;
+            {
+                unique_lock<mutex> lock(queue_mutex);
+                task_available.wait(lock, [this]() { return stopping || !tasks.empty(); });
+                if (stopping && tasks.empty()) {
+                    return;
+                }
+                task = move(tasks.front());
+                tasks.pop();
+            }
+            task();
+        }
+    }
+    
+public:
+    explicit ThreadPool(size_t thread_count) : stopping(false) {
+        thread_count = max<size_t>(1, thread_count);
+        workers.reserve(thread_count);
+        for (size_t i = 0; i < thread_count; i++) {
+            workers.emplace_back(&ThreadPool::workerLoop, this);
+        }
+    }
+    
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+    
+    // Runs any queued tasks to completion before joining the workers.
+    ~ThreadPool() {
+        {
+            lock_guard<mutex> lock(queue_mutex);
+            stopping = true;
+        }
+        task_available.notify_all();
+        for (auto& worker : workers) {
+            worker.join();
+        }
+    }
+    
+    // Exceptions thrown by the task are rethrown from future::get().
+    template<typename Task>
+    auto submit(Task task) -> future<decltype(task())> {
+        using Result = decltype(task());
+        auto packaged = make_shared<packaged_task<Result()>>(move(task));
+        future<Result> result = packaged->get_future();
+        {
+            lock_guard<mutex> lock(queue_mutex);
+            if (stopping) {
+                throw runtime_error("ThreadPool is shutting down");
+            }
+            tasks.emplace([packaged]() { (*packaged)(); });
+        }
+        task_available.notify_one();
+        return result;
+    }
+    
+    size_t getThreadCount() const { return workers.size(); }
+    
+    // A configured value of 0 (or less) means one thread per hardware core.
+    static size_t resolveThreadCount(int configured) {
+        if (configured > 0) {
+            return static_cast<size_t>(configured);
+        }
+        return max(1u, thread::hardware_concurrency());
+    }
+};
+
+// =============================================================================
+// PASSWORD KEY DERIVATION (SHA-256 / HMAC / PBKDF2)
+// =============================================================================
+//
+// SHA-256 (FIPS 180-4) and PBKDF2-HMAC-SHA256 (RFC 8018) implemented in-tree,
+// so stored PINs and passwords cost a configurable number of iterations to
+// test instead of a single std::hash call.
+
+class Sha256 {
+public:
+    static constexpr size_t DIGEST_SIZE = 32;
+    static constexpr size_t BLOCK_SIZE = 64;
+    using State = array<uint32_t, 8>;
+    using Digest = array<uint8_t, DIGEST_SIZE>;
+    
+private:
+    State state;
+    uint8_t buffer[BLOCK_SIZE];
+    size_t buffered;
+    uint64_t total_bytes;
+    
+    static uint32_t rotateRight(uint32_t value, int bits) {
+        return (value >> bits) | (value << (32 - bits));
+    }
+    
+public:
+    static constexpr State INITIAL_STATE = {
+        0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+    };
+    
+    Sha256() : state(INITIAL_STATE), buffered(0), total_bytes(0) {}
+    
+    // Resumes from a state that has already absorbed whole blocks, such as an HMAC key pad.
+    Sha256(const State& midstate, uint64_t bytes_absorbed) 
+        : state(midstate), buffered(0), total_bytes(bytes_absorbed) {}
+    
+    static void compress(State& hash, const uint8_t* block) {
+        static const uint32_t ROUND_CONSTANTS[64] = {
+            0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+            0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+            0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+            0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+            0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+            0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+            0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+            0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+        };
+        
+        uint32_t schedule[64];
+        for (int i = 0; i < 16; i++) {
+            schedule[i] = (static_cast<uint32_t>(block[i * 4]) << 24) | (static_cast<uint32_t>(block[i * 4 + 1]) << 16) |
+                          (static_cast<uint32_t>(block[i * 4 + 2]) << 8) | static_cast<uint32_t>(block[i * 4 + 3]);
+        }
+        for (int i = 16; i < 64; i++) {
+            uint32_t s0 = rotateRight(schedule[i - 15], 7) ^ rotateRight(schedule[i - 15], 18) ^ (schedule[i - 15] >> 3);
+            uint32_t s1 = rotateRight(schedule[i - 2], 17) ^ rotateRight(schedule[i - 2], 19) ^ (schedule[i - 2] >> 10);
+            schedule[i] = schedule[i - 16] + s0 + schedule[i - 7] + s1;
+        }
+        
+        uint32_t a = hash[0], b = hash[1], c = hash[2], d = hash[3];
+        uint32_t e = hash[4], f = hash[5], g = hash[6], h = hash[7];
+        for (int i = 0; i < 64; i++) {
+            uint32_t s1 = rotateRight(e, 6) ^ rotateRight(e, 11) ^ rotateRight(e, 25);
+            uint32_t choice = (e & f) ^ (~e & g);
+            uint32_t temp1 = h + s1 + choice + ROUND_CONSTANTS[i] + schedule[i];
+            uint32_t s0 = rotateRight(a, 2) ^ rotateRight(a, 13) ^ rotateRight(a, 22);
+            uint32_t majority = (a & b) ^ (a & c) ^ (b & c);
+            uint32_t temp2 = s0 + majority;
+            h = g; g = f; f = e; e = d + temp1;
+            d = c; c = b; b = a; a = temp1 + temp2;
+        }
+        hash[0] += a; hash[1] += b; hash[2] += c; hash[3] += d;
+        hash[4] += e; hash[5] += f; hash[6] += g; hash[7] += h;
+    }
+    
+    static void storeState(const State& hash, uint8_t* out) {
+        for (size_t i = 0; i < hash.size(); i++) {
+            out[i * 4] = static_cast<uint8_t>(hash[i] >> 24);
+            out[i * 4 + 1] = static_cast<uint8_t>(hash[i] >> 16);
+            out[i * 4 + 2] = static_cast<uint8_t>(hash[i] >> 8);
+            out[i * 4 + 3] = static_cast<uint8_t>(hash[i]);
+        }
+    }
+    
+    void update(const uint8_t* data, size_t length) {
+        total_bytes += length;
+        if (buffered > 0) {
+            size_t take = min(length, BLOCK_SIZE - buffered);
+            memcpy(buffer + buffered, data, take);
+            buffered += take;
+            data += take;
+            length -= take;
+            if (buffered < BLOCK_SIZE) return;
+            compress(state, buffer);
+            buffered = 0;
+        }
+        for (; length >= BLOCK_SIZE; data += BLOCK_SIZE, length -= BLOCK_SIZE) {
+            compress(state, data);
+        }
+        memcpy(buffer, data, length);
+        buffered = length;
+    }
+    
+    void update(const string& data) {
+        update(reinterpret_cast<const uint8_t*>(data.data()), data.size());
+    }
+    
+    Digest finish() {
+        uint64_t bit_length = total_bytes * 8;
+        buffer[buffered++] = 0x80;
+        if (buffered > BLOCK_SIZE - 8) {
+            memset(buffer + buffered, 0, BLOCK_SIZE - buffered);
+            compress(state, buffer);
+            buffered = 0;
+        }
+        memset(buffer + buffered, 0, BLOCK_SIZE - 8 - buffered);
+        for (int i = 0; i < 8; i++) {
+            buffer[BLOCK_SIZE - 1 - i] = static_cast<uint8_t>(bit_length >> (i * 8));
+        }
+        compress(state, buffer);
+        
+        Digest digest;
+        storeState(state, digest.data());
+        return digest;
+    }
+};
+
+constexpr Sha256::State Sha256::INITIAL_STATE;
+
+class PasswordKdf {
+private:
+    // HMAC key pads absorbed once, so each PBKDF2 iteration costs two compressions.
+    struct HmacKey {
+        Sha256::State inner;
+        Sha256::State outer;
+    };
+    
+    static HmacKey prepareKey(const string& key) {
+        uint8_t key_block[Sha256::BLOCK_SIZE] = {};
+        if (key.size() > Sha256::BLOCK_SIZE) {
+            Sha256 key_hash;
+            key_hash.update(key);
+            Sha256::Digest digest = key_hash.finish();
+            memcpy(key_block, digest.data(), digest.size());
+        } else {
+            memcpy(key_block, key.data(), key.size());
+        }
+        
+        HmacKey prepared{Sha256::INITIAL_STATE, Sha256::INITIAL_STATE};
+        uint8_t pad[Sha256::BLOCK_SIZE];
+        for (size_t i = 0; i < Sha256::BLOCK_SIZE; i++) pad[i] = key_block[i] ^ 0x36;
+        Sha256::compress(prepared.inner, pad);
+        for (size_t i = 0; i < Sha256::BLOCK_SIZE; i++) pad[i] = key_block[i] ^ 0x5c;
+        Sha256::compress(prepared.outer, pad);
+        return prepared;
+    }
+    
+public:
+    static Sha256::Digest hmacSha256(const string& key, const string& message) {
+        HmacKey prepared = prepareKey(key);
+        Sha256 inner(prepared.inner, Sha256::BLOCK_SIZE);
+        inner.update(message);
+        Sha256::Digest inner_digest = inner.finish();
+        Sha256 outer(prepared.outer, Sha256::BLOCK_SIZE);
+        outer.update(inner_digest.data(), inner_digest.size());
+        return outer.finish();
+    }
+    
+    // PBKDF2-HMAC-SHA256 with a single 32-byte output block, returned as hex.
+    static string pbkdf2Sha256Hex(const string& password, const string& salt, uint32_t iterations) {
+        HmacKey prepared = prepareKey(password);
+        
+        Sha256 first_inner(prepared.inner, Sha256::BLOCK_SIZE);
+        first_inner.update(salt);
+        const uint8_t block_index[4] = {0, 0, 0, 1};
+        first_inner.update(block_index, sizeof(block_index));
+        Sha256::Digest inner_digest = first_inner.finish();
+        Sha256 first_outer(prepared.outer, Sha256::BLOCK_SIZE);
+        first_outer.update(inner_digest.data(), inner_digest.size());
+        Sha256::Digest result = first_outer.finish();
+        
+        // Every later message is one 32-byte digest after a 64-byte key pad,
+        // so the padded block is fixed and only its first half changes.
+        uint8_t block[Sha256::BLOCK_SIZE] = {};
+        memcpy(block, result.data(), result.size());
+        block[Sha256::DIGEST_SIZE] = 0x80;
+        block[Sha256::BLOCK_SIZE - 2] = 0x03;  // (64 + 32) * 8 = 768 bits
+        for (uint32_t i = 1; i < iterations; i++) {
+            Sha256::State hash = prepared.inner;
+            Sha256::compress(hash, block);
+            Sha256::storeState(hash, block);
+            hash = prepared.outer;
+            Sha256::compress(hash, block);
+            Sha256::storeState(hash, block);
+            for (size_t j = 0; j < result.size(); j++) {
+                result[j] ^= block[j];
+            }
+        }
+        
+        static const char HEX_DIGITS[] = "0123456789abcdef";
+        string hex;
+        hex.reserve(result.size() * 2);
+        for (uint8_t byte : result) {
+            hex += HEX_DIGITS[byte >> 4];
+            hex += HEX_DIGITS[byte & 0x0f];
+        }
+        return hex;
+    }
+    
+    // Compares without an early exit so timing does not reveal the matching prefix.
+    static bool constantTimeEquals(const string& a, const string& b) {
+        if (a.size() != b.size()) return false;
+        unsigned char difference = 0;
+        for (size_t i = 0; i < a.size(); i++) {
+            difference |= static_cast<unsigned char>(a[i] ^ b[i]);
+        }
+        return difference == 0;
+    }
+};
+
 // =============================================================================
 // ENHANCED SECURITY MANAGER
 // =============================================================================
@@ -490,25 +1902,99 @@ private:
         return salt;
     }
     
+    // Pre-KDF format ("<hash>_<hash>"), kept only to verify hashes written by
+    // older versions until they are upgraded on the next successful login.
+    static string legacyHash(const string& input, const string& salt) {
+        hash<string> hasher;
+        string salted = salt + input + "BANKING_2025_ENTERPRISE";
+        return to_string(hasher(salted)) + "_" + to_string(hasher(salted + salt));
+    }
+    
+    // Stored hashes carry their own cost: "pbkdf2-sha256$<iterations>$<hex digest>".
+    static bool parseKdfHash(const string& stored_hash, uint32_t& iterations, string& digest_hex) {
+        if (stored_hash.compare(0, KDF_PREFIX.size(), KDF_PREFIX) != 0) {
+            return false;
+        }
+        size_t separator = stored_hash.find('$', KDF_PREFIX.size());
+        if (separator == string::npos) {
+            return false;
+        }
+        const char* first = stored_hash.data() + KDF_PREFIX.size();
+        const char* last = stored_hash.data() + separator;
+        auto parsed = from_chars(first, last, iterations);
+        if (parsed.ec != errc() || parsed.ptr != last || iterations == 0) {
+            return false;
+        }
+        digest_hex = stored_hash.substr(separator + 1);
+        return true;
+    }
+    
+    static bool& onAuthWorker() {
+        static thread_local bool on_worker = false;
+        return on_worker;
+    }
+    
 public:
+    static const string KDF_PREFIX;
+    static const int DEFAULT_KDF_ITERATIONS = 50000;
+    
     static void setConfig(ConfigManager* cfg) { config = cfg; }
     
+    static uint32_t getKdfIterations() {
+        int configured = config ? config->getInt("security.kdf_iterations", DEFAULT_KDF_ITERATIONS) : DEFAULT_KDF_ITERATIONS;
+        return static_cast<uint32_t>(max(1000, configured));
+    }
+    
     static pair<string, string> hashWithSalt(const string& input) {
         size_t salt_length = config ? config->getInt("security.salt_length", 16) : 16;
         string salt = generateSalt(salt_length);
-        hash<string> hasher;
-        string salted = salt + input + "BANKING_2025_ENTERPRISE";
-        string hashed = to_string(hasher(salted)) + "_" + to_string(hasher(salted + salt));
+        uint32_t iterations = getKdfIterations();
+        string hashed = KDF_PREFIX + to_string(iterations) + "$" + PasswordKdf::pbkdf2Sha256Hex(input, salt, iterations);
         
-        Logger::getInstance().debug("Password hashed with salt length: " + to_string(salt_length));
+        Logger::getInstance().debug("Password hashed with salt length: " + to_string(salt_length) + 
+                                   ", KDF iterations: " + to_string(iterations));
         return {hashed, salt};
     }
     
     static bool verifyHash(const string& input, const string& stored_hash, const string& salt) {
-        hash<string> hasher;
-        string salted = salt + input + "BANKING_2025_ENTERPRISE";
-        string computed = to_string(hasher(salted)) + "_" + to_string(hasher(salted + salt));
-        return computed == stored_hash;
+        uint32_t iterations = 0;
+        string digest_hex;
+        if (parseKdfHash(stored_hash, iterations, digest_hex)) {
+            return PasswordKdf::constantTimeEquals(PasswordKdf::pbkdf2Sha256Hex(input, salt, iterations), digest_hex);
+        }
+        return PasswordKdf::constantTimeEquals(legacyHash(input, salt), stored_hash);
+    }
+    
+    // True for legacy hashes and for KDF hashes cheaper than the configured cost.
+    static bool needsRehash(const string& stored_hash) {
+        uint32_t iterations = 0;
+        string digest_hex;
+        return !parseKdfHash(stored_hash, iterations, digest_hex) || iterations < getKdfIterations();
+    }
+    
+    // KDF work runs on a small dedicated pool (security.auth_threads, 0 = one
+    // per core) so a login storm queues there instead of taking cores from
+    // transaction processing.
+    static ThreadPool& getAuthPool() {
+        static ThreadPool auth_pool(ThreadPool::resolveThreadCount(config ? config->getInt("security.auth_threads", 2) : 2));
+        return auth_pool;
+    }
+    
+    template<typename Task>
+    static auto submitAuthTask(Task task) -> future<decltype(task())> {
+        return getAuthPool().submit([task]() mutable {
+            onAuthWorker() = true;
+            return task();
+        });
+    }
+    
+    // Runs the task on the auth pool and waits; runs inline when already on it.
+    template<typename Task>
+    static auto runAuthTask(Task task) -> decltype(task()) {
+        if (onAuthWorker()) {
+            return task();
+        }
+        return submitAuthTask(move(task)).get();
     }
     
     static string generateOTP() {
@@ -521,19 +2007,20 @@ public:
     static bool isValidPin(const string& pin) {
         if (!config) return pin.length() == 4 && all_of(pin.begin(), pin.end(), ::isdigit);
         
-        int required_length = config->getInt("security.pin_length", 4);
+        int required_length = config->snapshot().pin_length;
         return pin.length() == required_length && all_of(pin.begin(), pin.end(), ::isdigit);
     }
     
     static bool isValidPassword(const string& password) {
         if (!config) return password.length() >= 6;
         
-        int min_length = config->getInt("security.min_password_length", 6);
+        int min_length = config->snapshot().min_password_length;
         return password.length() >= min_length;
     }
 };
 
 ConfigManager* SecurityManager::config = nullptr;
+const string SecurityManager::KDF_PREFIX = "pbkdf2-sha256$";
 
 // =============================================================================
 // ENHANCED INPUT VALIDATION WITH MONETARY PRECISION
@@ -548,9 +2035,9 @@ public:
     
     static long long getValidAmountInPaise(const string& prompt, long long custom_min = -1, long long custom_max = -1) {
         long long min_paise = (custom_min >= 0) ? custom_min : 
-                             (config ? config->getLongLong("amount.min_amount_paise", 1) : 1);
+                             (config ? config->snapshot().min_amount_paise : 1);
         long long max_paise = (custom_max >= 0) ? custom_max : 
-                             (config ? config->getLongLong("amount.max_amount_paise", 100000000) : 100000000);
+                             (config ? config->snapshot().max_amount_paise : 100000000);
         
         double amount_rupees;
         long long amount_paise;
@@ -579,6 +2066,12 @@ public:
         return amount_paise;
     }
     
+    static bool isValidAmount(long long amount_paise) {
+        long long min_paise = config ? config->snapshot().min_amount_paise : 1;
+        long long max_paise = config ? config->snapshot().max_amount_paise : 100000000;
+        return amount_paise >= min_paise && amount_paise <= max_paise;
+    }
+    
     static bool isValidPhoneNumber(const string& phone) {
         return phone.size() == 10 && all_of(phone.begin(), phone.end(), ::isdigit);
     }
@@ -586,8 +2079,8 @@ public:
     static bool isValidAccountNumber(int acc_no) {
         if (!config) return acc_no > 0 && acc_no <= 999999;
         
-        int min_acc = config->getInt("account.min_account_number", 100001);
-        int max_acc = config->getInt("account.max_account_number", 999999);
+        int min_acc = config->snapshot().min_account_number;
+        int max_acc = config->snapshot().max_account_number;
         return acc_no >= min_acc && acc_no <= max_acc;
     }
     
@@ -647,8 +2140,8 @@ public:
     }
     
     static int getValidAccountNumber(const string& prompt) {
-        int min_acc = config ? config->getInt("account.min_account_number", 100001) : 100001;
-        int max_acc = config ? config->getInt("account.max_account_number", 999999) : 999999;
+        int min_acc = config ? config->snapshot().min_account_number : 100001;
+        int max_acc = config ? config->snapshot().max_account_number : 999999;
         return getValidIntInRange(prompt, min_acc, max_acc);
     }
 };
@@ -660,7 +2153,7 @@ ConfigManager* InputValidator::config = nullptr;
 // =============================================================================
 
 class TransactionManager {
-private:
+public:
     struct AccountSnapshot {
         int account_no;
         long long previous_balance_paise;
@@ -668,6 +2161,7 @@ private:
         bool modified;
     };
     
+private:
     vector<AccountSnapshot> snapshots;
     bool transaction_active;
     
@@ -737,6 +2231,7 @@ public:
         }
         
         vector<AccountSnapshot> rollback_data = snapshots;
+        MetricCounters::add(MetricCounter::TRANSACTION_ROLLBACKS);
         transaction_active = false;
         
         Logger::getInstance().warning("Transaction manager: Transaction rolled back for " + 
@@ -756,1834 +2251,7325 @@ public:
 };
 
 // =============================================================================
-// ENHANCED TRANSACTION CLASS WITH MONETARY PRECISION AND UTC
+// ZERO-COPY RECORD PARSING
 // =============================================================================
+//
+// Splits pipe-delimited records into string_views over the caller's buffer
+// (a line, a file buffer or an mmap) and converts numeric fields with
+// from_chars. Field splitting and number conversion deliberately mirror the
+// getline('|') + stoll/stoi/stof code they replace - including leading
+// whitespace, an optional '+' and ignored trailing characters - so parsed
+// objects are identical. Failures carry the 1-based column of the bad field.
 
-class Transaction {
+class RecordParseException : public invalid_argument {
 private:
-    string transaction_id;
-    TransactionType type;
-    long long amount_in_paise;
-    long long balance_after_in_paise;
-    time_t timestamp_utc;
-    string description;
+    size_t column_number;
     
 public:
-    Transaction(TransactionType t_type, long long amt_paise, long long balance_paise, const string& desc = "") 
-        : type(t_type), amount_in_paise(amt_paise), balance_after_in_paise(balance_paise), description(desc) {
-        timestamp_utc = TimeUtils::getCurrentUTC();
-        transaction_id = "TXN" + to_string(timestamp_utc % 1000000);
-    }
+    RecordParseException(const string& msg, size_t column) : invalid_argument(msg), column_number(column) {}
+    size_t getColumn() const { return column_number; }
+};
+
+class RecordFields {
+private:
+    string_view record;
+    vector<string_view> fields;
     
-    Transaction(const string& txn_id, TransactionType t_type, long long amt_paise, long long balance_paise, 
-                time_t ts, const string& desc = "")
-        : transaction_id(txn_id), type(t_type), amount_in_paise(amt_paise), 
-          balance_after_in_paise(balance_paise), timestamp_utc(ts), description(desc) {}
+    // Returns the offset of the first character from_chars should see.
+    static size_t skipNumberPrefix(string_view text) {
+        size_t pos = 0;
+        while (pos < text.size() && isspace(static_cast<unsigned char>(text[pos]))) pos++;
+        if (pos + 1 < text.size() && text[pos] == '+' && text[pos + 1] != '+' && text[pos + 1] != '-') pos++;
+        return pos;
+    }
     
-    void display() const {
-        cout << left << setw(12) << transaction_id
-             << setw(18) << transactionTypeToString(type)
-             << setw(15) << MoneyUtils::formatCurrency(amount_in_paise)
-             << setw(15) << MoneyUtils::formatCurrency(balance_after_in_paise)
-             << setw(25) << TimeUtils::formatTimestampUTC(timestamp_utc);
-        
-        if (!description.empty()) {
-            cout << " | " << description;
+public:
+    explicit RecordFields(string_view line, char delimiter = '|') : record(line) {
+        fields.reserve(16);
+        size_t start = 0;
+        while (start < line.size()) {
+            size_t end = line.find(delimiter, start);
+            if (end == string_view::npos) {
+                fields.push_back(line.substr(start));
+                break;
+            }
+            fields.push_back(line.substr(start, end - start));
+            start = end + 1;
         }
-        cout << endl;
     }
     
-    string getTransactionId() const { return transaction_id; }
-    TransactionType getType() const { return type; }
-    string getTypeString() const { return transactionTypeToString(type); }
-    long long getAmountInPaise() const { return amount_in_paise; }
-    double getAmountInRupees() const { return MoneyUtils::paiseToRupees(amount_in_paise); }
-    time_t getTimestamp() const { return timestamp_utc; }
-    long long getBalanceAfterInPaise() const { return balance_after_in_paise; }
-    double getBalanceAfterInRupees() const { return MoneyUtils::paiseToRupees(balance_after_in_paise); }
-    string getDescription() const { return description; }
+    size_t size() const { return fields.size(); }
     
-    string toCSV() const {
-        return transaction_id + "|" + transactionTypeToString(type) + "|" + 
-               to_string(amount_in_paise) + "|" + to_string(balance_after_in_paise) + "|" + 
-               to_string(timestamp_utc) + "|" + description;
+    // Missing fields read as empty, as an exhausted getline would leave them.
+    string_view operator[](size_t index) const {
+        return index < fields.size() ? fields[index] : string_view();
     }
     
-    static Transaction fromCSV(const string& csv_line) {
-        stringstream ss(csv_line);
-        string txn_id, type_str, amt_str, bal_str, ts_str, desc;
-        
-        getline(ss, txn_id, '|');
-        getline(ss, type_str, '|');
-        getline(ss, amt_str, '|');
-        getline(ss, bal_str, '|');
-        getline(ss, ts_str, '|');
-        getline(ss, desc, '|');
+    size_t columnOf(size_t index) const {
+        return index < fields.size() ? static_cast<size_t>(fields[index].data() - record.data()) + 1 : record.size() + 1;
+    }
+    
+    string getString(size_t index) const {
+        return string((*this)[index]);
+    }
+    
+    long long getLongLong(size_t index) const {
+        string_view text = (*this)[index];
+        size_t pos = skipNumberPrefix(text);
+        long long value = 0;
+        auto result = from_chars(text.data() + pos, text.data() + text.size(), value);
+        if (result.ec == errc::invalid_argument) {
+            throw RecordParseException("expected integer in field " + to_string(index + 1), columnOf(index));
+        }
+        if (result.ec == errc::result_out_of_range) {
+            throw RecordParseException("integer out of range in field " + to_string(index + 1), columnOf(index));
+        }
+        return value;
+    }
+    
+    int getInt(size_t index) const {
+        long long value = getLongLong(index);
+        if (value < INT_MIN || value > INT_MAX) {
+            throw RecordParseException("integer out of range in field " + to_string(index + 1), columnOf(index));
+        }
+        return static_cast<int>(value);
+    }
+    
+    float getFloat(size_t index) const {
+        string_view text = (*this)[index];
+        size_t pos = skipNumberPrefix(text);
+        float value = 0.0f;
+        
+        // strtof also accepts hexadecimal floats ("0x1.8p3")
+        bool negative = (pos < text.size() && text[pos] == '-');
+        size_t hex_pos = pos + (negative ? 1 : 0);
+        if (hex_pos + 1 < text.size() && text[hex_pos] == '0' && (text[hex_pos + 1] == 'x' || text[hex_pos + 1] == 'X')) {
+            auto hex_result = from_chars(text.data() + hex_pos + 2, text.data() + text.size(), value, chars_format::hex);
+            if (hex_result.ec == errc::result_out_of_range) {
+                throw RecordParseException("number out of range in field " + to_string(index + 1), columnOf(index));
+            }
+            if (hex_result.ec == errc::invalid_argument) {
+                value = 0.0f;  // a bare "0x" reads as the leading zero
+            }
+            return negative ? -value : value;
+        }
         
-        return Transaction(txn_id, stringToTransactionType(type_str), stoll(amt_str), 
-                          stoll(bal_str), static_cast<time_t>(stoll(ts_str)), desc);
+        auto result = from_chars(text.data() + pos, text.data() + text.size(), value);
+        if (result.ec == errc::invalid_argument) {
+            throw RecordParseException("expected number in field " + to_string(index + 1), columnOf(index));
+        }
+        if (result.ec == errc::result_out_of_range) {
+            throw RecordParseException("number out of range in field " + to_string(index + 1), columnOf(index));
+        }
+        return value;
     }
 };
 
 // =============================================================================
-// ACCOUNT MANAGER WITH CONFIGURATION SUPPORT
+// COLLISION-FREE 64-BIT TRANSACTION ID GENERATOR
 // =============================================================================
+//
+// Layout (most significant first):
+//   41 bits  milliseconds since 2025-01-01 UTC
+//    6 bits  node id (transaction.node_id)
+//    6 bits  thread slot
+//   10 bits  per-thread sequence within the millisecond
+// Each thread claims a free slot from an atomic bitmask, so IDs are generated
+// without locks. A thread that exhausts its sequence borrows the next
+// millisecond instead of spinning; the slot's high-water mark is handed on
+// to the next thread that claims it, keeping IDs unique across slot reuse.
+// The last slot is shared: threads beyond the first 63 draw from one atomic
+// sequence there rather than waiting for a slot to free up. At startup the
+// transaction index raises a floor above the newest stored ID, so a clock
+// that stepped back across a restart cannot reissue old IDs.
 
-class AccountManager {
+class TransactionIdGenerator {
 private:
-    static int next_account_number;
+    static constexpr uint64_t EPOCH_MS = 1735689600000ULL;
+    static constexpr int SEQUENCE_BITS = 10;
+    static constexpr int SLOT_BITS = 6;
+    static constexpr int NODE_BITS = 6;
+    static constexpr uint64_t MAX_SEQUENCE = (1ULL << SEQUENCE_BITS) - 1;
+    static constexpr int SLOT_COUNT = 1 << SLOT_BITS;
+    static constexpr int SHARED_SLOT = SLOT_COUNT - 1;
+    static constexpr int MAX_NODE_ID = (1 << NODE_BITS) - 1;
+    static constexpr int TIMESTAMP_SHIFT = NODE_BITS + SLOT_BITS + SEQUENCE_BITS;
+    
     static ConfigManager* config;
+    static atomic<uint64_t> node_id;
+    static atomic<uint64_t> slot_mask;
+    static array<atomic<uint64_t>, SLOT_COUNT> slot_last_ms;
+    static atomic<uint64_t> shared_state;  // (milliseconds << SEQUENCE_BITS) | sequence
+    static atomic<uint64_t> floor_ms;
     
-public:
-    static void setConfig(ConfigManager* cfg) { 
-        config = cfg; 
-        if (config) {
-            next_account_number = config->getInt("account.starting_account_number", 100000);
-        }
-    }
+    // Never waits: IDs are generated inside Transaction constructors whose
+    // callers hold account locks and the persistence gate.
+    static int acquireSlot() {
+        uint64_t mask = slot_mask.load(memory_order_acquire);
+        while (true) {
+            int slot = 0;
+            while (slot < SHARED_SLOT && (mask & (1ULL << slot))) {
+                slot++;
+            }
+            if (slot == SHARED_SLOT) {
+                return SHARED_SLOT;
+            }
+            if (slot_mask.compare_exchange_weak(mask, mask | (1ULL << slot), memory_order_acq_rel)) {
+                return slot;
+            }
+        }
+    }
     
-    static int generateUniqueAccountNumber() {
-        return ++next_account_number;
+    struct ThreadState {
+        int slot;
+        uint64_t last_ms;
+        uint64_t sequence;
+        
+        ThreadState() : slot(acquireSlot()), last_ms(0), sequence(MAX_SEQUENCE) {
+            if (slot != SHARED_SLOT) {
+                last_ms = slot_last_ms[slot].load(memory_order_acquire);
+            }
+        }
+        
+        ~ThreadState() {
+            if (slot != SHARED_SLOT) {
+                slot_last_ms[slot].store(last_ms, memory_order_release);
+                slot_mask.fetch_and(~(1ULL << slot), memory_order_acq_rel);
+            }
+        }
+    };
+    
+    static uint64_t nextShared(uint64_t now_ms) {
+        uint64_t current = shared_state.load(memory_order_relaxed);
+        while (true) {
+            uint64_t last_ms = current >> SEQUENCE_BITS;
+            uint64_t next;
+            if (now_ms > last_ms) {
+                next = now_ms << SEQUENCE_BITS;
+            } else if ((current & MAX_SEQUENCE) < MAX_SEQUENCE) {
+                next = current + 1;
+            } else {
+                next = (last_ms + 1) << SEQUENCE_BITS;
+            }
+            if (shared_state.compare_exchange_weak(current, next, memory_order_relaxed)) {
+                return next;
+            }
+        }
     }
     
-    static void setNextAccountNumber(int next) {
-        next_account_number = next;
+    static uint64_t currentMillis() {
+        uint64_t now_ms = static_cast<uint64_t>(chrono::duration_cast<chrono::milliseconds>(
+            chrono::system_clock::now().time_since_epoch()).count());
+        return now_ms > EPOCH_MS ? now_ms - EPOCH_MS : 0;
     }
     
-    static int getNextAccountNumber() {
-        return next_account_number;
+public:
+    static void setConfig(ConfigManager* cfg) {
+        config = cfg;
+        int configured = cfg ? cfg->getInt("transaction.node_id", 0) : 0;
+        node_id.store(static_cast<uint64_t>(max(0, min(configured, MAX_NODE_ID))));
     }
-};
-
-int AccountManager::next_account_number = 100000;
-ConfigManager* AccountManager::config = nullptr;
-
-// =============================================================================
-// ENHANCED BASE ACCOUNT CLASS WITH MONETARY PRECISION
-// =============================================================================
-
-class Account {
-protected:
-    int acc_no;
-    string phone_number;
-    string name;
-    string address;
-    long long balance_in_paise;
-    vector<Transaction> transaction_history;
-    time_t created_date_utc;
-    static ConfigManager* config;
     
-    int getMaxHistoryLimit() const {
-        return config ? config->getInt("transaction.max_history_per_account", 500) : 500;
+    // Called with each stored ID found at startup; later IDs use later milliseconds.
+    static void observeExistingId(uint64_t id) {
+        uint64_t next_ms = (id >> TIMESTAMP_SHIFT) + 1;
+        uint64_t current = floor_ms.load(memory_order_relaxed);
+        while (next_ms > current && !floor_ms.compare_exchange_weak(current, next_ms, memory_order_relaxed)) {
+        }
     }
-
-public:
-    static void setConfig(ConfigManager* cfg) { config = cfg; }
     
-    virtual void getAccountInfo() {
-        cout << "\nAccount Creation Options:" << endl;
-        cout << "1. Auto-generate account number" << endl;
-        cout << "2. Choose your own account number" << endl;
-        int choice = InputValidator::getValidChoice("Enter choice: ", 1, 2);
-        
-        if (choice == 1) {
-            acc_no = AccountManager::generateUniqueAccountNumber();
-            cout << "Auto-generated Account Number: " << acc_no << endl;
-            Logger::getInstance().info("Auto-generated account number: " + to_string(acc_no));
+    static uint64_t generate() {
+        thread_local ThreadState state;
+        
+        uint64_t now_ms = max(currentMillis(), floor_ms.load(memory_order_relaxed));
+        uint64_t ms;
+        uint64_t sequence;
+        if (state.slot == SHARED_SLOT) {
+            uint64_t packed = nextShared(now_ms);
+            ms = packed >> SEQUENCE_BITS;
+            sequence = packed & MAX_SEQUENCE;
         } else {
-            acc_no = InputValidator::getValidAccountNumber("Enter Account number: ");
+            if (now_ms > state.last_ms) {
+                state.last_ms = now_ms;
+                state.sequence = 0;
+            } else if (state.sequence < MAX_SEQUENCE) {
+                state.sequence++;
+            } else {
+                state.last_ms++;
+                state.sequence = 0;
+            }
+            ms = state.last_ms;
+            sequence = state.sequence;
         }
         
-        name = InputValidator::getValidString("Enter Name: ");
-        phone_number = InputValidator::getValidPhoneNumber("Enter Phone Number (10 digits): ");
-        address = InputValidator::getValidString("Enter Address: ");
-        balance_in_paise = InputValidator::getValidAmountInPaise("Enter Initial Balance: Rs. ");
-        
-        created_date_utc = TimeUtils::getCurrentUTC();
-        recordTransaction(TransactionType::ACCOUNT_CREATED, balance_in_paise, "Account opened with initial deposit");
-        
-        Logger::getInstance().info("Account created: " + to_string(acc_no) + " for " + name);
+        return (ms << TIMESTAMP_SHIFT)
+             | (node_id.load(memory_order_relaxed) << (SLOT_BITS + SEQUENCE_BITS))
+             | (static_cast<uint64_t>(state.slot) << SEQUENCE_BITS)
+             | sequence;
     }
-
-    virtual void displayAccountInfo() const {
-        cout << "\n--- Account Details ---";
-        cout << "\nAccount No. : " << acc_no;
-        cout << "\nName        : " << name;
-        cout << "\nPhone No.   : " << phone_number;
-        cout << "\nAddress     : " << address;
-        cout << "\nBalance     : " << MoneyUtils::formatCurrency(balance_in_paise);
-        cout << "\nCreated     : " << TimeUtils::formatTimestampUTC(created_date_utc);
-        cout << "\nAccount Type: " << accountTypeToString(getAccountType());
+    
+    static string format(uint64_t id) {
+        return "TXN" + to_string(id);
     }
-
-    void recordTransaction(TransactionType type, long long amount_paise, const string& description = "") {
-        Transaction trans(type, amount_paise, balance_in_paise, description);
-        transaction_history.push_back(trans);
-        
-        int max_history = getMaxHistoryLimit();
-        if (transaction_history.size() > max_history) {
-            transaction_history.erase(transaction_history.begin());
+    
+    // Accepts "TXN<digits>" as well as bare digits; legacy six-digit IDs
+    // parse to their numeric value. Returns 0 for anything unparseable.
+    static uint64_t parse(string_view text) {
+        size_t start = (text.compare(0, 3, "TXN") == 0) ? 3 : 0;
+        if (start >= text.size() || text.size() - start > 20) return 0;
+        
+        uint64_t id = 0;
+        for (size_t i = start; i < text.size(); i++) {
+            if (!isdigit(static_cast<unsigned char>(text[i]))) return 0;
+            uint64_t digit = static_cast<uint64_t>(text[i] - '0');
+            if (id > (UINT64_MAX - digit) / 10) return 0;
+            id = id * 10 + digit;
         }
-        
-        saveTransactionToFile(trans);
-        Logger::getInstance().info("Transaction recorded - Account: " + to_string(acc_no) + 
-                                  ", Type: " + transactionTypeToString(type) + 
-                                  ", Amount: " + MoneyUtils::formatCurrency(amount_paise));
+        return id;
     }
     
-    virtual void credit(long long amount_paise) {
-        balance_in_paise = MoneyUtils::addMoney(balance_in_paise, amount_paise);
-        recordTransaction(TransactionType::CREDIT, amount_paise);
+    static time_t getTimestamp(uint64_t id) {
+        uint64_t ms = id >> TIMESTAMP_SHIFT;
+        return static_cast<time_t>((ms + EPOCH_MS) / 1000);
     }
+};
+
+ConfigManager* TransactionIdGenerator::config = nullptr;
+atomic<uint64_t> TransactionIdGenerator::node_id(0);
+atomic<uint64_t> TransactionIdGenerator::slot_mask(0);
+array<atomic<uint64_t>, TransactionIdGenerator::SLOT_COUNT> TransactionIdGenerator::slot_last_ms{};
+atomic<uint64_t> TransactionIdGenerator::shared_state(0);
+atomic<uint64_t> TransactionIdGenerator::floor_ms(0);
+
+// =============================================================================
+// ENHANCED TRANSACTION CLASS WITH MONETARY PRECISION AND UTC
+// =============================================================================
+
+class Transaction {
+private:
+    uint64_t transaction_id;
+    TransactionType type;
+    long long amount_in_paise;
+    long long balance_after_in_paise;
+    time_t timestamp_utc;
+    string description;
     
-    virtual void debit(long long amount_paise) {
-        if (amount_paise > balance_in_paise) {
-            throw InsufficientFundsException("Cannot debit " + MoneyUtils::formatCurrency(amount_paise) + 
-                                           " from account " + to_string(acc_no) + 
-                                           ". Available balance: " + MoneyUtils::formatCurrency(balance_in_paise));
-        }
-        balance_in_paise = MoneyUtils::subtractMoney(balance_in_paise, amount_paise);
-        recordTransaction(TransactionType::DEBIT, amount_paise);
+public:
+    Transaction(TransactionType t_type, long long amt_paise, long long balance_paise, const string& desc = "") 
+        : type(t_type), amount_in_paise(amt_paise), balance_after_in_paise(balance_paise), description(desc) {
+        timestamp_utc = TimeUtils::getCurrentUTC();
+        transaction_id = TransactionIdGenerator::generate();
     }
     
-    void showTransactionHistory(int limit = 10, TransactionType filter_type = static_cast<TransactionType>(-1)) const {
-        cout << "\n=== TRANSACTION HISTORY ===" << endl;
-        cout << left << setw(12) << "TXN ID"
-             << setw(18) << "TYPE"
-             << setw(15) << "AMOUNT"
-             << setw(15) << "BALANCE"
-             << setw(25) << "TIMESTAMP (UTC)"
-             << "DESCRIPTION" << endl;
-        cout << string(110, '-') << endl;
-        
-        if (transaction_history.empty()) {
-            cout << "No transactions found." << endl;
-            return;
-        }
-        
-        vector<Transaction> filtered_transactions;
-        for (const auto& trans : transaction_history) {
-            if (filter_type == static_cast<TransactionType>(-1) || trans.getType() == filter_type) {
-                filtered_transactions.push_back(trans);
-            }
-        }
+    Transaction(uint64_t txn_id, TransactionType t_type, long long amt_paise, long long balance_paise, 
+                time_t ts, const string& desc = "")
+        : transaction_id(txn_id), type(t_type), amount_in_paise(amt_paise), 
+          balance_after_in_paise(balance_paise), timestamp_utc(ts), description(desc) {}
+    
+    void display() const {
+        cout << left << setw(24) << TransactionIdGenerator::format(transaction_id)
+             << setw(18) << transactionTypeToString(type)
+             << setw(15) << MoneyUtils::formatCurrency(amount_in_paise)
+             << setw(15) << MoneyUtils::formatCurrency(balance_after_in_paise)
+             << setw(25) << TimeUtils::formatTimestampUTC(timestamp_utc);
         
-        int start = max(0, (int)filtered_transactions.size() - limit);
-        for (int i = start; i < (int)filtered_transactions.size(); i++) {
-            filtered_transactions[i].display();
+        if (!description.empty()) {
+            cout << " | " << description;
         }
-        
-        cout << "Showing " << min(limit, (int)filtered_transactions.size()) 
-             << " of " << filtered_transactions.size() << " transactions" << endl;
+        cout << endl;
     }
     
-    void generateAccountStatement() const {
-        cout << "\n=== ACCOUNT STATEMENT ===" << endl;
-        displayAccountInfo();
-        showTransactionHistory(50);
+    uint64_t getTransactionId() const { return transaction_id; }
+    TransactionType getType() const { return type; }
+    string getTypeString() const { return transactionTypeToString(type); }
+    long long getAmountInPaise() const { return amount_in_paise; }
+    double getAmountInRupees() const { return MoneyUtils::paiseToRupees(amount_in_paise); }
+    time_t getTimestamp() const { return timestamp_utc; }
+    long long getBalanceAfterInPaise() const { return balance_after_in_paise; }
+    double getBalanceAfterInRupees() const { return MoneyUtils::paiseToRupees(balance_after_in_paise); }
+    string getDescription() const { return description; }
+    
+    string toCSV() const {
+        return TransactionIdGenerator::format(transaction_id) + "|" + transactionTypeToString(type) + "|" + 
+               to_string(amount_in_paise) + "|" + to_string(balance_after_in_paise) + "|" + 
+               to_string(timestamp_utc) + "|" + description;
     }
     
-    void saveTransactionToFile(const Transaction& trans) const {
-        string data_dir = config ? config->getString("directory.data", "data") : "data";
-        create_directories(data_dir);
+    static Transaction fromCSV(string_view csv_line) {
+        RecordFields fields(csv_line);
+        long long amount_paise = fields.getLongLong(2);
+        long long balance_paise = fields.getLongLong(3);
+        time_t timestamp = static_cast<time_t>(fields.getLongLong(4));
         
-        string filename = data_dir + "/transactions_" + to_string(acc_no) + ".txt";
-        ofstream file(filename, ios::app);
-        if (file.is_open()) {
-            file << trans.toCSV() << endl;
-            file.close();
-        }
+        return Transaction(TransactionIdGenerator::parse(fields[0]), stringToTransactionType(fields[1]), amount_paise, 
+                          balance_paise, timestamp, fields.getString(5));
     }
+};
+
+// =============================================================================
+// FIXED-CAPACITY CIRCULAR BUFFER FOR BOUNDED TRANSACTION HISTORY
+// =============================================================================
+//
+// Appending to a full buffer overwrites the oldest element in O(1) instead of
+// shifting the whole history. Iteration is oldest-to-newest; use rbegin()/
+// rend() for newest-first.
+
+template<typename T>
+class CircularBuffer {
+private:
+    vector<T> items;
+    size_t head;        // Index of the oldest element once the buffer is full
+    size_t max_items;
     
-    void loadTransactionHistory() {
-        string data_dir = config ? config->getString("directory.data", "data") : "data";
-        string filename = data_dir + "/transactions_" + to_string(acc_no) + ".txt";
-        
-        ifstream file(filename);
-        if (!file.is_open()) {
-            Logger::getInstance().debug("No transaction history found for account: " + to_string(acc_no));
-            return;
+    size_t physicalIndex(size_t logical_index) const {
+        size_t index = head + logical_index;
+        return index >= items.size() ? index - items.size() : index;
+    }
+    
+public:
+    class const_iterator {
+    private:
+        const CircularBuffer* buffer;
+        size_t index;
+        
+    public:
+        using iterator_category = random_access_iterator_tag;
+        using value_type = T;
+        using difference_type = ptrdiff_t;
+        using pointer = const T*;
+        using reference = const T&;
+        
+        const_iterator() : buffer(nullptr), index(0) {}
+        const_iterator(const CircularBuffer* buf, size_t idx) : buffer(buf), index(idx) {}
+        
+        reference operator*() const { return (*buffer)[index]; }
+        pointer operator->() const { return &(*buffer)[index]; }
+        reference operator[](difference_type n) const { return (*buffer)[index + n]; }
+        
+        const_iterator& operator++() { ++index; return *this; }
+        const_iterator operator++(int) { const_iterator tmp = *this; ++index; return tmp; }
+        const_iterator& operator--() { --index; return *this; }
+        const_iterator operator--(int) { const_iterator tmp = *this; --index; return tmp; }
+        const_iterator& operator+=(difference_type n) { index += n; return *this; }
+        const_iterator& operator-=(difference_type n) { index -= n; return *this; }
+        const_iterator operator+(difference_type n) const { return const_iterator(buffer, index + n); }
+        const_iterator operator-(difference_type n) const { return const_iterator(buffer, index - n); }
+        difference_type operator-(const const_iterator& other) const {
+            return static_cast<difference_type>(index) - static_cast<difference_type>(other.index);
         }
         
-        string line;
-        transaction_history.clear();
-        
-        while (getline(file, line) && !line.empty()) {
-            try {
-                Transaction trans = Transaction::fromCSV(line);
-                transaction_history.push_back(trans);
-            } catch (const exception& e) {
-                Logger::getInstance().warning("Skipped corrupted transaction record for account " + 
-                                            to_string(acc_no) + ": " + e.what());
-                continue;
-            }
+        bool operator==(const const_iterator& other) const { return index == other.index; }
+        bool operator!=(const const_iterator& other) const { return index != other.index; }
+        bool operator<(const const_iterator& other) const { return index < other.index; }
+        bool operator>(const const_iterator& other) const { return index > other.index; }
+        bool operator<=(const const_iterator& other) const { return index <= other.index; }
+        bool operator>=(const const_iterator& other) const { return index >= other.index; }
+    };
+    
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+    
+    explicit CircularBuffer(size_t capacity = 1) : head(0), max_items(max<size_t>(capacity, 1)) {}
+    
+    // Changing the capacity keeps the newest elements.
+    void setCapacity(size_t capacity) {
+        capacity = max<size_t>(capacity, 1);
+        if (capacity == max_items) return;
+        
+        vector<T> newest;
+        size_t keep = min(items.size(), capacity);
+        newest.reserve(keep);
+        for (size_t i = items.size() - keep; i < items.size(); i++) {
+            newest.push_back(move(items[physicalIndex(i)]));
         }
-        file.close();
-        Logger::getInstance().info("Loaded " + to_string(transaction_history.size()) + 
-                                  " transactions for account " + to_string(acc_no));
+        items = move(newest);
+        head = 0;
+        max_items = capacity;
     }
-
-    // Getters
-    int getAccountNumber() const { return acc_no; }
-    string getName() const { return name; }
-    string getPhoneNumber() const { return phone_number; }
-    string getAddress() const { return address; }
-    long long getBalanceInPaise() const { return balance_in_paise; }
-    double getBalanceInRupees() const { return MoneyUtils::paiseToRupees(balance_in_paise); }
-    virtual AccountType getAccountType() const = 0;
-    const vector<Transaction>& getTransactionHistory() const { return transaction_history; }
-    time_t getCreatedDate() const { return created_date_utc; }
     
-    void setAccountDetails(int acc, const string& n, const string& ph, const string& addr, 
-                          long long bal_paise, time_t created = 0) {
-        acc_no = acc;
-        name = n;
-        phone_number = ph;
-        address = addr;
-        balance_in_paise = bal_paise;
-        created_date_utc = (created == 0) ? TimeUtils::getCurrentUTC() : created;
-        
-        if (acc >= AccountManager::getNextAccountNumber()) {
-            AccountManager::setNextAccountNumber(acc);
+    void push_back(const T& value) {
+        if (items.size() < max_items) {
+            items.push_back(value);
+        } else {
+            items[head] = value;
+            head = (head + 1 == items.size()) ? 0 : head + 1;
         }
-        
-        loadTransactionHistory();
     }
     
-    void setBalanceInPaise(long long paise) {
-        balance_in_paise = paise;
+    void push_back(T&& value) {
+        if (items.size() < max_items) {
+            items.push_back(move(value));
+        } else {
+            items[head] = move(value);
+            head = (head + 1 == items.size()) ? 0 : head + 1;
+        }
     }
-
-    virtual void processWithdrawal() = 0;
-    virtual void processDeposit() = 0;
-    virtual ~Account() {}
+    
+    void clear() {
+        items.clear();
+        head = 0;
+    }
+    
+    void reserve(size_t count) { items.reserve(min(count, max_items)); }
+    
+    const T& operator[](size_t logical_index) const { return items[physicalIndex(logical_index)]; }
+    const T& front() const { return (*this)[0]; }
+    const T& back() const { return (*this)[items.size() - 1]; }
+    
+    size_t size() const { return items.size(); }
+    size_t capacity() const { return max_items; }
+    bool empty() const { return items.empty(); }
+    
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, items.size()); }
+    const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+    const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
 };
 
-ConfigManager* Account::config = nullptr;
-
 // =============================================================================
-// ENHANCED SAVINGS ACCOUNT CLASS WITH PRECISE MONETARY CALCULATIONS
+// ACCOUNT MANAGER WITH CONFIGURATION SUPPORT
 // =============================================================================
 
-class SavingsAccount : public Account {
-protected:
-    float interest_rate;
-
+class AccountManager {
+private:
+    static atomic<int> next_account_number;
+    static ConfigManager* config;
+    
 public:
-    void getAccountInfo() override {
-        Account::getAccountInfo();
-        
-        float min_rate = config ? config->getFloat("savings.min_interest_rate", 0.1f) : 0.1f;
-        float max_rate = config ? config->getFloat("savings.max_interest_rate", 15.0f) : 15.0f;
-        
-        cout << "Enter rate of interest (" << min_rate << "-" << max_rate << "%): ";
-        do {
-            cin >> interest_rate;
-            if (interest_rate < min_rate || interest_rate > max_rate) {
-                cout << "Interest rate must be between " << min_rate << "% and " << max_rate << "%. Try again: ";
-            }
-        } while (interest_rate < min_rate || interest_rate > max_rate);
-        
-        Logger::getInstance().info("Savings account created with " + to_string(interest_rate) + "% interest rate");
-    }
-
-    void processWithdrawal() override {
-        try {
-            long long amount_paise = InputValidator::getValidAmountInPaise("\nEnter amount to withdraw: Rs. ");
-            
-            if (amount_paise > balance_in_paise) {
-                throw InsufficientFundsException("Cannot withdraw " + MoneyUtils::formatCurrency(amount_paise) + 
-                                               ". Available balance: " + MoneyUtils::formatCurrency(balance_in_paise));
-            }
-            
-            balance_in_paise = MoneyUtils::subtractMoney(balance_in_paise, amount_paise);
-            recordTransaction(TransactionType::WITHDRAWAL, amount_paise, "ATM/Branch withdrawal");
-            cout << "\nWithdrawal successful! New balance: " << MoneyUtils::formatCurrency(balance_in_paise) << endl;
-            
-        } catch (const BankingException& e) {
-            cout << "\nTransaction failed: " << e.what() << endl;
-        }
-    }
-
-    void processDeposit() override {
-        try {
-            long long amount_paise = InputValidator::getValidAmountInPaise("\nEnter amount to deposit: Rs. ");
-            
-            balance_in_paise = MoneyUtils::addMoney(balance_in_paise, amount_paise);
-            recordTransaction(TransactionType::DEPOSIT, amount_paise, "Cash/Cheque deposit");
-            cout << "\nDeposit successful! New balance: " << MoneyUtils::formatCurrency(balance_in_paise) << endl;
-            
-        } catch (const exception& e) {
-            cout << "\nDeposit failed: " << e.what() << endl;
-            Logger::getInstance().error("Deposit failed for account " + to_string(acc_no) + ": " + e.what());
+    static void setConfig(ConfigManager* cfg) { 
+        config = cfg; 
+        if (config) {
+            next_account_number = config->getInt("account.starting_account_number", 100000);
         }
     }
-
-    long long calculateInterestInPaise() const {
-        return MoneyUtils::calculatePercentage(balance_in_paise, interest_rate);
-    }
     
-    void applyMonthlyInterest() {
-        long long interest_paise = calculateInterestInPaise();
-        balance_in_paise = MoneyUtils::addMoney(balance_in_paise, interest_paise);
-        recordTransaction(TransactionType::INTEREST_APPLIED, interest_paise, "Monthly interest credited");
-        cout << "Monthly interest of " << MoneyUtils::formatCurrency(interest_paise) 
-             << " applied to account " << acc_no << endl;
-        
-        Logger::getInstance().info("Interest applied - Account: " + to_string(acc_no) + 
-                                  ", Amount: " + MoneyUtils::formatCurrency(interest_paise));
+    static int generateUniqueAccountNumber() {
+        return ++next_account_number;
     }
-
-    void displayAccountInfo() const override {
-        Account::displayAccountInfo();
-        cout << "\nInterest Rate : " << fixed << setprecision(1) << interest_rate << "%";
-        cout << "\nInterest to be Earned: " << MoneyUtils::formatCurrency(calculateInterestInPaise()) << endl;
+    
+    static void setNextAccountNumber(int next) {
+        next_account_number = next;
     }
     
-    AccountType getAccountType() const override {
-        return AccountType::SAVINGS;
+    // Raise the counter to at least acc; safe to call from parallel loaders
+    static void observeAccountNumber(int acc) {
+        int current = next_account_number.load();
+        while (acc > current && !next_account_number.compare_exchange_weak(current, acc)) {}
     }
     
-    float getInterestRate() const { return interest_rate; }
-    void setInterestRate(float rate) { interest_rate = rate; }
+    static int getNextAccountNumber() {
+        return next_account_number;
+    }
 };
 
+atomic<int> AccountManager::next_account_number{100000};
+ConfigManager* AccountManager::config = nullptr;
+
 // =============================================================================
-// ENHANCED CURRENT ACCOUNT CLASS WITH PRECISE OVERDRAFT HANDLING
+// POOLED, BUFFERED APPENDER FOR PER-ACCOUNT TRANSACTION FILES
 // =============================================================================
+//
+// Keeps an LRU-bounded pool of open transactions_<acc>.txt streams and
+// buffers records per account. Buffers are written with a single write call
+// according to transaction_log.flush_policy:
+//   per_commit - on commit() at the end of each persisted operation
+//   time       - once the oldest pending record is flush_interval_ms old
+//   size       - once an account buffer reaches flush_bytes
 
-class CurrentAccount : public Account {
-protected:
-    long long overdraft_limit_paise;
-    long long overdraft_cap_paise;
+enum class FlushPolicy {
+    PER_COMMIT,
+    TIME_BASED,
+    SIZE_BASED
+};
 
-public:
-    void getAccountInfo() override {
-        Account::getAccountInfo();
-        overdraft_limit_paise = InputValidator::getValidAmountInPaise("Enter Overdraft Limit: Rs. ");
-        overdraft_cap_paise = overdraft_limit_paise;
-        Logger::getInstance().info("Current account created with " + MoneyUtils::formatCurrency(overdraft_limit_paise) + " overdraft limit");
+class TransactionFileAppender {
+private:
+    struct PooledFile {
+        int account_no;
+        string path;
+        ofstream stream;
+        uint64_t end_offset;  // file size including pending bytes
+        string pending;
+        chrono::steady_clock::time_point oldest_pending;
+    };
+    
+    static ConfigManager* config;
+    list<PooledFile> pool;
+    unordered_map<int, list<PooledFile>::iterator> pool_index;
+    string prepared_directory;
+    mutex appender_mutex;
+    condition_variable flusher_cv;
+    thread flusher_thread;
+    bool stop_flusher;
+    
+    TransactionFileAppender() : stop_flusher(false) {}
+    
+    FlushPolicy getFlushPolicy() const {
+        string policy = config ? config->snapshot().flush_policy : "per_commit";
+        if (policy == "time") return FlushPolicy::TIME_BASED;
+        if (policy == "size") return FlushPolicy::SIZE_BASED;
+        return FlushPolicy::PER_COMMIT;
     }
-
-    void processWithdrawal() override {
-        try {
-            long long amount_paise = InputValidator::getValidAmountInPaise("\nEnter amount to withdraw: Rs. ");
-
-            if (amount_paise > (balance_in_paise + overdraft_limit_paise)) {
-                throw InsufficientFundsException("Amount exceeds available balance and overdraft limit");
-            }
-            
-            if (amount_paise > balance_in_paise) {
-                long long from_overdraft = amount_paise - balance_in_paise;
-                balance_in_paise = 0;
-                overdraft_limit_paise = MoneyUtils::subtractMoney(overdraft_limit_paise, from_overdraft);
-                recordTransaction(TransactionType::OVERDRAFT_WITHDRAWAL, amount_paise, 
-                                "Withdrawal using overdraft facility");
-            } else {
-                balance_in_paise = MoneyUtils::subtractMoney(balance_in_paise, amount_paise);
-                recordTransaction(TransactionType::WITHDRAWAL, amount_paise, "Regular withdrawal");
-            }
-            
-            cout << "\nWithdrawal successful!" << endl;
-            cout << "Available Balance: " << MoneyUtils::formatCurrency(balance_in_paise) << endl;
-            cout << "Available Overdraft: " << MoneyUtils::formatCurrency(overdraft_limit_paise) << endl;
-            
-        } catch (const BankingException& e) {
-            cout << "\nTransaction failed: " << e.what() << endl;
-        }
+    
+    size_t getMaxOpenFiles() const {
+        int max_open = config ? config->snapshot().max_open_files : 64;
+        return static_cast<size_t>(max(1, max_open));
     }
-
-    void processDeposit() override {
-        try {
-            long long amount_paise = InputValidator::getValidAmountInPaise("\nEnter amount to deposit: Rs. ");
-            int choice = InputValidator::getValidChoice(
-                "Where to deposit?\n1. Account Balance\n2. Repay Overdraft\nChoice: ", 1, 2);
-            
-            switch (choice) {
-                case 1:
-                    balance_in_paise = MoneyUtils::addMoney(balance_in_paise, amount_paise);
-                    recordTransaction(TransactionType::DEPOSIT, amount_paise, "Regular deposit");
-                    break;
-                case 2: {
-                    if ((overdraft_limit_paise + amount_paise) > overdraft_cap_paise) {
-                        long long to_repay = overdraft_cap_paise - overdraft_limit_paise;
-                        if (to_repay > 0) {
-                            cout << "Repaying " << MoneyUtils::formatCurrency(to_repay) << " to overdraft, " 
-                                 << MoneyUtils::formatCurrency(amount_paise - to_repay) << " to balance." << endl;
-                            overdraft_limit_paise = overdraft_cap_paise;
-                            balance_in_paise = MoneyUtils::addMoney(balance_in_paise, amount_paise - to_repay);
-                            recordTransaction(TransactionType::OVERDRAFT_REPAY, to_repay, "Overdraft repayment");
-                            if (amount_paise - to_repay > 0) {
-                                recordTransaction(TransactionType::DEPOSIT, amount_paise - to_repay, "Excess amount to balance");
-                            }
-                        } else {
-                            cout << "Overdraft full. Depositing to main balance." << endl;
-                            balance_in_paise = MoneyUtils::addMoney(balance_in_paise, amount_paise);
-                            recordTransaction(TransactionType::DEPOSIT, amount_paise, "Deposit to balance (overdraft full)");
-                        }
-                    } else {
-                        overdraft_limit_paise = MoneyUtils::addMoney(overdraft_limit_paise, amount_paise);
-                        recordTransaction(TransactionType::OVERDRAFT_REPAY, amount_paise, "Overdraft limit restoration");
-                    }
-                    break;
-                }
-            }
-            
-            cout << "\nDeposit successful!" << endl;
-            cout << "Available Balance: " << MoneyUtils::formatCurrency(balance_in_paise) << endl;
-            cout << "Available Overdraft: " << MoneyUtils::formatCurrency(overdraft_limit_paise) << endl;
-            
-        } catch (const BankingException& e) {
-            cout << "\nDeposit failed: " << e.what() << endl;
-        }
+    
+    size_t getFlushBytes() const {
+        int flush_bytes = config ? config->snapshot().flush_bytes : 65536;
+        return static_cast<size_t>(max(1, flush_bytes));
     }
-
-    void displayAccountInfo() const override {
-        Account::displayAccountInfo();
-        cout << "\nOverdraft Limit: " << MoneyUtils::formatCurrency(overdraft_limit_paise) 
-             << " of " << MoneyUtils::formatCurrency(overdraft_cap_paise) << endl;
+    
+    chrono::milliseconds getFlushInterval() const {
+        int interval = config ? config->snapshot().flush_interval_ms : 200;
+        return chrono::milliseconds(max(1, interval));
     }
     
-    AccountType getAccountType() const override {
-        return AccountType::CURRENT;
+    string getDataDirectory() const {
+        return config ? config->snapshot().data_directory : "data";
     }
     
-    long long getOverdraftLimitInPaise() const { return overdraft_limit_paise; }
-    long long getOverdraftCapInPaise() const { return overdraft_cap_paise; }
-    double getOverdraftLimitInRupees() const { return MoneyUtils::paiseToRupees(overdraft_limit_paise); }
-    double getOverdraftCapInRupees() const { return MoneyUtils::paiseToRupees(overdraft_cap_paise); }
+    void writePending(PooledFile& entry) {
+        if (entry.pending.empty()) return;
+        
+        entry.stream.write(entry.pending.data(), entry.pending.size());
+        entry.stream.flush();
+        if (!entry.stream.good()) {
+            Logger::getInstance().error("Failed to append transactions for account " + to_string(entry.account_no));
+            entry.stream.clear();
+            error_code ec;
+            uintmax_t actual_size = filesystem::file_size(entry.path, ec);
+            entry.end_offset = ec ? 0 : actual_size;
+        }
+        entry.pending.clear();
+    }
     
-    void setOverdraftDetails(long long limit_paise, long long cap_paise) { 
-        overdraft_limit_paise = limit_paise; 
-        overdraft_cap_paise = cap_paise; 
+    void evictLeastRecentlyUsed() {
+        PooledFile& victim = pool.back();
+        writePending(victim);
+        victim.stream.close();
+        pool_index.erase(victim.account_no);
+        pool.pop_back();
     }
-};
-
-// =============================================================================
-// ENHANCED LOAN ACCOUNT CLASS WITH PRECISE EMI CALCULATIONS
-// =============================================================================
-
-class LoanAccount : public Account {
-protected:
-    long long principal_amount_paise;
-    float loan_interest_rate;
-    int tenure_months;
-    long long emi_amount_paise;
-    int payments_made;
-
-public:
-    void getAccountInfo() override {
-        Account::getAccountInfo();
-        principal_amount_paise = balance_in_paise;
-        
-        float min_rate = config ? config->getFloat("loan.min_interest_rate", 1.0f) : 1.0f;
-        float max_rate = config ? config->getFloat("loan.max_interest_rate", 20.0f) : 20.0f;
-        int min_tenure = config ? config->getInt("loan.min_tenure_months", 6) : 6;
-        int max_tenure = config ? config->getInt("loan.max_tenure_months", 360) : 360;
-        
-        cout << "Enter annual interest rate (" << min_rate << "-" << max_rate << "%): ";
-        do {
-            cin >> loan_interest_rate;
-            if (loan_interest_rate < min_rate || loan_interest_rate > max_rate) {
-                cout << "Interest rate must be between " << min_rate << "% and " << max_rate << "%. Try again: ";
+    
+    PooledFile* acquire(int account_no) {
+        string data_dir = getDataDirectory();
+        if (data_dir != prepared_directory) {
+            // Pooled streams still point into the previous directory
+            while (!pool.empty()) {
+                evictLeastRecentlyUsed();
             }
-        } while (loan_interest_rate < min_rate || loan_interest_rate > max_rate);
+            create_directories(data_dir);
+            prepared_directory = data_dir;
+        }
         
-        cout << "Enter loan tenure in months (" << min_tenure << "-" << max_tenure << "): ";
-        do {
-            cin >> tenure_months;
-            if (tenure_months < min_tenure || tenure_months > max_tenure) {
-                cout << "Tenure must be between " << min_tenure << " and " << max_tenure << " months. Try again: ";
-            }
-        } while (tenure_months < min_tenure || tenure_months > max_tenure);
+        auto it = pool_index.find(account_no);
+        if (it != pool_index.end()) {
+            pool.splice(pool.begin(), pool, it->second);
+            return &pool.front();
+        }
         
-        payments_made = 0;
-        calculateEMI();
+        while (pool.size() >= getMaxOpenFiles()) {
+            evictLeastRecentlyUsed();
+        }
         
-        Logger::getInstance().info("Loan account created - Principal: " + MoneyUtils::formatCurrency(principal_amount_paise) +
-                                  ", Rate: " + to_string(loan_interest_rate) + "%, Tenure: " + to_string(tenure_months) + " months");
+        pool.emplace_front();
+        PooledFile& entry = pool.front();
+        entry.account_no = account_no;
+        entry.path = pathFor(data_dir, account_no);
+        entry.stream.open(entry.path, ios::app | ios::binary);
+        error_code ec;
+        uintmax_t existing_size = filesystem::file_size(entry.path, ec);
+        entry.end_offset = ec ? 0 : existing_size;
+        if (!entry.stream.is_open()) {
+            pool.pop_front();
+            Logger::getInstance().error("Cannot open transaction file for account " + to_string(account_no));
+            return nullptr;
+        }
+        pool_index[account_no] = pool.begin();
+        return &entry;
     }
     
-    void calculateEMI() {
-        float monthly_rate = loan_interest_rate / (12 * 100);
-        float factor = pow(1 + monthly_rate, tenure_months);
-        double emi_rupees = (MoneyUtils::paiseToRupees(principal_amount_paise) * monthly_rate * factor) / (factor - 1);
-        emi_amount_paise = MoneyUtils::rupeesToPaise(emi_rupees);
-    }
-
-    void processWithdrawal() override {
-        cout << "Withdrawal not allowed on loan accounts. Use processDeposit() to make EMI payments." << endl;
-    }
-
-    void processDeposit() override {
-        try {
-            cout << "EMI Amount: " << MoneyUtils::formatCurrency(emi_amount_paise) << endl;
-            cout << "Outstanding Balance: " << MoneyUtils::formatCurrency(balance_in_paise) << endl;
-            
-            int choice = InputValidator::getValidChoice(
-                "\n1. Pay EMI (" + to_string((int)MoneyUtils::paiseToRupees(emi_amount_paise)) + 
-                ")\n2. Pay Custom Amount\nChoice: ", 1, 2);
-            
-            long long payment_amount_paise;
-            if (choice == 1) {
-                payment_amount_paise = emi_amount_paise;
-            } else {
-                payment_amount_paise = InputValidator::getValidAmountInPaise("Enter payment amount: Rs. ");
+    void flushExpired(chrono::steady_clock::time_point now) {
+        chrono::milliseconds interval = getFlushInterval();
+        for (auto& entry : pool) {
+            if (!entry.pending.empty() && now - entry.oldest_pending >= interval) {
+                writePending(entry);
             }
-            
-            if (payment_amount_paise > balance_in_paise) {
-                payment_amount_paise = balance_in_paise;
-                cout << "Payment adjusted to outstanding balance: " << MoneyUtils::formatCurrency(payment_amount_paise) << endl;
+        }
+    }
+    
+    void startFlusher() {
+        if (flusher_thread.joinable()) return;
+        flusher_thread = thread([this]() {
+            unique_lock<mutex> lock(appender_mutex);
+            while (!stop_flusher) {
+                flusher_cv.wait_for(lock, getFlushInterval());
+                flushExpired(chrono::steady_clock::now());
             }
-            
-            balance_in_paise = MoneyUtils::subtractMoney(balance_in_paise, payment_amount_paise);
-            payments_made++;
-            recordTransaction(TransactionType::EMI_PAYMENT, payment_amount_paise, 
-                            "EMI payment #" + to_string(payments_made));
-            
-            cout << "\nPayment successful!" << endl;
-            cout << "Outstanding Loan Balance: " << MoneyUtils::formatCurrency(balance_in_paise) << endl;
-            cout << "Payments Made: " << payments_made << " of " << tenure_months << endl;
-            
-            if (balance_in_paise <= 0) {
-                cout << "🎉 Congratulations! Loan has been fully paid!" << endl;
-                balance_in_paise = 0;
-                recordTransaction(TransactionType::LOAN_CLOSED, 0, "Loan account closed - fully paid");
-                Logger::getInstance().info("Loan fully paid - Account: " + to_string(acc_no));
+        });
+    }
+    
+public:
+    static void setConfig(ConfigManager* cfg) { config = cfg; }
+    
+    static string pathFor(const string& data_dir, int account_no) {
+        return data_dir + "/transactions_" + to_string(account_no) + ".txt";
+    }
+    
+    // Account numbers that have a transactions_<acc>.txt file in data_dir.
+    static vector<int> listAccountFiles(const string& data_dir) {
+        vector<int> account_numbers;
+        const string prefix = "transactions_";
+        const string suffix = ".txt";
+        
+        error_code ec;
+        for (const auto& dir_entry : filesystem::directory_iterator(data_dir, ec)) {
+            string filename = dir_entry.path().filename().string();
+            if (filename.size() <= prefix.size() + suffix.size() || filename.compare(0, prefix.size(), prefix) != 0 ||
+                filename.compare(filename.size() - suffix.size(), suffix.size(), suffix) != 0) {
+                continue;
             }
-            
-        } catch (const exception& e) {
-            cout << "\nPayment failed: " << e.what() << endl;
+            string acc_text = filename.substr(prefix.size(), filename.size() - prefix.size() - suffix.size());
+            if (acc_text.size() > 9 || !all_of(acc_text.begin(), acc_text.end(), ::isdigit)) continue;
+            account_numbers.push_back(stoi(acc_text));
         }
+        sort(account_numbers.begin(), account_numbers.end());
+        return account_numbers;
     }
-
-    void displayAccountInfo() const override {
-        Account::displayAccountInfo();
-        cout << "\nPrincipal Amount: " << MoneyUtils::formatCurrency(principal_amount_paise);
-        cout << "\nInterest Rate: " << loan_interest_rate << "% per annum";
-        cout << "\nTenure: " << tenure_months << " months";
-        cout << "\nEMI Amount: " << MoneyUtils::formatCurrency(emi_amount_paise);
-        cout << "\nPayments Made: " << payments_made << " of " << tenure_months;
-        cout << "\nOutstanding Balance: " << MoneyUtils::formatCurrency(balance_in_paise) << endl;
+    
+    static TransactionFileAppender& getInstance() {
+        static TransactionFileAppender instance;
+        return instance;
     }
     
-    AccountType getAccountType() const override {
-        return AccountType::LOAN;
+    TransactionFileAppender(const TransactionFileAppender&) = delete;
+    TransactionFileAppender& operator=(const TransactionFileAppender&) = delete;
+    
+    ~TransactionFileAppender() {
+        shutdown();
     }
     
-    long long getPrincipalAmountInPaise() const { return principal_amount_paise; }
-    double getPrincipalAmountInRupees() const { return MoneyUtils::paiseToRupees(principal_amount_paise); }
-    float getLoanInterestRate() const { return loan_interest_rate; }
-    int getTenureMonths() const { return tenure_months; }
-    long long getEMIAmountInPaise() const { return emi_amount_paise; }
-    double getEMIAmountInRupees() const { return MoneyUtils::paiseToRupees(emi_amount_paise); }
-    int getPaymentsMade() const { return payments_made; }
-    
-    void setLoanDetails(long long principal_paise, float rate, int tenure, int payments) {
-        principal_amount_paise = principal_paise;
-        loan_interest_rate = rate;
-        tenure_months = tenure;
-        payments_made = payments;
-        calculateEMI();
-    }
-};
-
-// =============================================================================
-// ENHANCED USER CLASS
-// =============================================================================
-
-class User {
-private:
-    string username;
-    string hashed_password;
-    string salt;
-    vector<int> owned_accounts;
-    UserRole role;
-    time_t created_date;
-    time_t last_login;
-
-public:
-    User() : role(UserRole::USER) {
-        created_date = TimeUtils::getCurrentUTC();
-        last_login = 0;
+    // Joins the background flusher and writes everything buffered. The
+    // flusher reads the ConfigManager, so owners call this before it is
+    // destroyed; a later time-based append starts a new flusher.
+    void shutdown() {
+        thread stopping;
+        {
+            lock_guard<mutex> lock(appender_mutex);
+            stop_flusher = true;
+            stopping = move(flusher_thread);
+        }
+        flusher_cv.notify_all();
+        if (stopping.joinable()) {
+            stopping.join();
+        }
+        {
+            lock_guard<mutex> lock(appender_mutex);
+            stop_flusher = false;
+        }
+        flushAll();
     }
     
-    User(const string& user, const string& pass, UserRole r = UserRole::USER) : username(user), role(r) {
-        auto hash_result = SecurityManager::hashWithSalt(pass);
-        hashed_password = hash_result.first;
-        salt = hash_result.second;
-        created_date = TimeUtils::getCurrentUTC();
-        last_login = 0;
+    static constexpr uint64_t NO_OFFSET = UINT64_MAX;
+    
+    // Returns the byte offset the record will occupy in the account's file,
+    // or NO_OFFSET if the file could not be opened.
+    uint64_t append(int account_no, const string& record) {
+        lock_guard<mutex> lock(appender_mutex);
         
-        Logger::getInstance().info("User created: " + username + " with role: " + 
-                                  (r == UserRole::ADMIN ? "ADMIN" : "USER"));
+        PooledFile* entry = acquire(account_no);
+        if (!entry) return NO_OFFSET;
+        
+        if (entry->pending.empty()) {
+            entry->oldest_pending = chrono::steady_clock::now();
+        }
+        uint64_t record_offset = entry->end_offset;
+        entry->pending += record;
+        entry->pending += '\n';
+        entry->end_offset += record.size() + 1;
+        
+        switch (getFlushPolicy()) {
+            case FlushPolicy::SIZE_BASED:
+                if (entry->pending.size() >= getFlushBytes()) {
+                    writePending(*entry);
+                }
+                break;
+            case FlushPolicy::TIME_BASED:
+                startFlusher();
+                flushExpired(chrono::steady_clock::now());
+                break;
+            case FlushPolicy::PER_COMMIT:
+                break;
+        }
+        return record_offset;
     }
     
-    bool authenticate(const string& password) {
-        bool success = SecurityManager::verifyHash(password, hashed_password, salt);
-        if (success) {
-            last_login = TimeUtils::getCurrentUTC();
-            Logger::getInstance().info("Successful authentication for user: " + username);
-        } else {
-            Logger::getInstance().warning("Failed authentication attempt for user: " + username);
+    // Marks the end of a persisted operation. Returns true if every record
+    // appended so far is now written, so index entries for them may follow.
+    bool commit() {
+        if (getFlushPolicy() == FlushPolicy::PER_COMMIT) {
+            flushAll();
+            return true;
         }
-        return success;
+        return false;
     }
     
-    void addAccount(int acc_no) {
-        if (find(owned_accounts.begin(), owned_accounts.end(), acc_no) == owned_accounts.end()) {
-            owned_accounts.push_back(acc_no);
-            Logger::getInstance().info("Account " + to_string(acc_no) + " assigned to user: " + username);
+    // Forces one account's buffered records to disk, e.g. before reading its file.
+    void flush(int account_no) {
+        lock_guard<mutex> lock(appender_mutex);
+        auto it = pool_index.find(account_no);
+        if (it != pool_index.end()) {
+            writePending(*it->second);
         }
     }
     
-    bool ownsAccount(int acc_no) const {
-        return find(owned_accounts.begin(), owned_accounts.end(), acc_no) != owned_accounts.end();
+    void flushAll() {
+        lock_guard<mutex> lock(appender_mutex);
+        for (auto& entry : pool) {
+            writePending(entry);
+        }
     }
     
-    bool isAdmin() const {
-        return role == UserRole::ADMIN;
+    // Writes and closes every pooled file. Callers that have held off all
+    // other writers may then use appendUnpooled; later appends reopen the
+    // files and pick up their new size.
+    void closeAll() {
+        lock_guard<mutex> lock(appender_mutex);
+        while (!pool.empty()) {
+            evictLeastRecentlyUsed();
+        }
     }
     
-    // Getters and setters
-    string getUsername() const { return username; }
-    const vector<int>& getOwnedAccounts() const { return owned_accounts; }
-    UserRole getRole() const { return role; }
-    time_t getLastLogin() const { return last_login; }
-    
-    void setUserDetails(const string& user, const string& hashedPass, const string& user_salt, 
-                       const vector<int>& accounts, UserRole r = UserRole::USER, 
-                       time_t created = 0, time_t login = 0) {
-        username = user;
-        hashed_password = hashedPass;
-        salt = user_salt;
-        owned_accounts = accounts;
-        role = r;
-        created_date = (created == 0) ? TimeUtils::getCurrentUTC() : created;
-        last_login = login;
+    // Appends already-formatted records through a private handle, bypassing
+    // the pool and its lock. Returns the offset of the first byte written,
+    // or NO_OFFSET on failure.
+    static uint64_t appendUnpooled(const string& data_dir, int account_no, const string& records) {
+        string file_path = pathFor(data_dir, account_no);
+        error_code ec;
+        uintmax_t existing_size = filesystem::file_size(file_path, ec);
+        uint64_t record_offset = ec ? 0 : existing_size;
+        
+        ofstream stream(file_path, ios::app | ios::binary);
+        if (!stream.is_open()) {
+            Logger::getInstance().error("Cannot open transaction file for account " + to_string(account_no));
+            return NO_OFFSET;
+        }
+        stream.write(records.data(), records.size());
+        stream.flush();
+        if (!stream.good()) {
+            Logger::getInstance().error("Failed to append transactions for account " + to_string(account_no));
+            return NO_OFFSET;
+        }
+        return record_offset;
     }
     
-    string getHashedPassword() const { return hashed_password; }
-    string getSalt() const { return salt; }
-    
-    string toDataString() const {
-        stringstream ss;
-        ss << username << "|" << hashed_password << "|" << salt << "|" << static_cast<int>(role) 
-           << "|" << created_date << "|" << last_login;
-        for (int acc_no : owned_accounts) {
-            ss << "|" << acc_no;
-        }
-        return ss.str();
+    size_t getOpenFileCount() {
+        lock_guard<mutex> lock(appender_mutex);
+        return pool.size();
     }
 };
 
+ConfigManager* TransactionFileAppender::config = nullptr;
+
 // =============================================================================
-// ENHANCED AUTHENTICATION MANAGER WITH THREAD SAFETY
+// PERSISTENT TRANSACTION-ID INDEX
 // =============================================================================
+//
+// data/txn_index.dat is an append-only array of fixed-size entries mapping a
+// transaction ID to the account file and byte offset of its record. The
+// whole index is held in a hash map, so a lookup is one probe plus a single
+// positioned read of one line. New entries are buffered as records are
+// appended and written at each commit; --rebuild-txn-index regenerates the
+// file from the transaction files if it is lost or out of date.
 
-class AuthenticationManager {
+struct TransactionIndexEntry {
+    uint64_t transaction_id;
+    uint64_t offset;
+    int32_t account_no;
+    uint32_t record_length;
+};
+
+static_assert(sizeof(TransactionIndexEntry) == 24, "Transaction index entries must stay 24 bytes");
+
+class TransactionIdIndex {
+public:
+    struct Location {
+        int account_no;
+        uint64_t offset;
+        uint32_t record_length;
+    };
+    
 private:
-    unordered_map<int, pair<string, string>> account_pins;
-    unordered_map<int, int> failed_attempts;
-    unordered_map<int, string> active_otps;
     static ConfigManager* config;
-    mutable mutex auth_mutex;
+    unordered_map<uint64_t, Location> locations;
+    vector<TransactionIndexEntry> pending;
+    string index_path;
+    bool loaded;
+    mutex index_mutex;
     
-    int getMaxAttempts() const {
-        return config ? config->getInt("security.max_pin_attempts", 3) : 3;
+    TransactionIdIndex() : loaded(false) {}
+    
+    static string getDataDirectory() {
+        return config ? config->snapshot().data_directory : "data";
     }
     
-public:
-    static void setConfig(ConfigManager* cfg) { config = cfg; }
+    static string indexPathFor(const string& data_dir) {
+        return data_dir + "/txn_index.dat";
+    }
     
-    bool registerPin(int acc_no) {
-        lock_guard<mutex> lock(auth_mutex);
-        
-        string pin, confirm_pin;
-        
-        do {
-            cout << "Set " << (config ? config->getInt("security.pin_length", 4) : 4) << "-digit PIN: ";
-            cin >> pin;
-            
-            if (!SecurityManager::isValidPin(pin)) {
-                cout << "PIN must be exactly " << (config ? config->getInt("security.pin_length", 4) : 4) << " digits!" << endl;
-                continue;
-            }
-            
-            cout << "Confirm PIN: ";
-            cin >> confirm_pin;
-            
-            if (pin != confirm_pin) {
-                cout << "PINs do not match! Try again." << endl;
-                continue;
-            }
-            
-            break;
-        } while (true);
-        
-        auto hash_result = SecurityManager::hashWithSalt(pin);
-        account_pins[acc_no] = {hash_result.first, hash_result.second};
-        failed_attempts[acc_no] = 0;
-        
-        Logger::getInstance().info("PIN registered for account: " + to_string(acc_no));
-        cout << "PIN set successfully!" << endl;
-        savePins();
-        return true;
+    void insertEntry(const TransactionIndexEntry& entry) {
+        // Legacy IDs are not unique; the most recent record wins
+        locations[entry.transaction_id] = {entry.account_no, entry.offset, entry.record_length};
     }
     
-    bool authenticate(int acc_no) {
-        lock_guard<mutex> lock(auth_mutex);
+    bool flushLocked() {
+        if (pending.empty()) return true;
         
-        if (account_pins.find(acc_no) == account_pins.end()) {
-            cout << "No PIN set for this account. Please set PIN first." << endl;
-            return registerPin(acc_no);
+        ofstream file(index_path, ios::app | ios::binary);
+        if (!file.is_open()) {
+            Logger::getInstance().error("Cannot open transaction index: " + index_path);
+            return false;
         }
-        
-        int max_attempts = getMaxAttempts();
-        if (failed_attempts[acc_no] >= max_attempts) {
-            cout << "Account locked due to multiple failed attempts!" << endl;
-            Logger::getInstance().warning("Account " + to_string(acc_no) + " is locked due to failed attempts");
+        file.write(reinterpret_cast<const char*>(pending.data()), pending.size() * sizeof(TransactionIndexEntry));
+        if (!file.good()) {
+            Logger::getInstance().error("Failed to append to transaction index: " + index_path);
             return false;
         }
-        
-        string pin;
-        cout << "Enter " << (config ? config->getInt("security.pin_length", 4) : 4) << "-digit PIN: ";
-        cin >> pin;
-        
-        auto& pin_data = account_pins[acc_no];
-        if (SecurityManager::verifyHash(pin, pin_data.first, pin_data.second)) {
-            failed_attempts[acc_no] = 0;
-            Logger::getInstance().info("Successful PIN authentication for account: " + to_string(acc_no));
-            return true;
+        pending.clear();
+        return true;
+    }
+    
+    void loadLocked() {
+        flushLocked();
+        locations.clear();
+        pending.clear();
+        index_path = indexPathFor(getDataDirectory());
+        loaded = true;
+        
+        error_code ec;
+        uintmax_t file_size = filesystem::file_size(index_path, ec);
+        if (ec || file_size == 0) return;
+        
+        // Drop a torn trailing entry so later appends stay aligned
+        uintmax_t whole_size = file_size - file_size % sizeof(TransactionIndexEntry);
+        if (whole_size != file_size) {
+            filesystem::resize_file(index_path, whole_size, ec);
+            Logger::getInstance().warning("Transaction index had a partial trailing entry - truncated");
         }
         
-        failed_attempts[acc_no]++;
-        int remaining = max_attempts - failed_attempts[acc_no];
-        
-        if (remaining > 0) {
-            cout << "Wrong PIN! " << remaining << " attempts remaining." << endl;
-            Logger::getInstance().warning("Failed PIN attempt for account " + to_string(acc_no) + 
-                                        ", " + to_string(remaining) + " attempts remaining");
-        } else {
-            cout << "Account locked due to multiple failed attempts!" << endl;
-            Logger::getInstance().error("Account " + to_string(acc_no) + " locked due to failed PIN attempts");
+        vector<TransactionIndexEntry> entries(whole_size / sizeof(TransactionIndexEntry));
+        ifstream file(index_path, ios::binary);
+        file.read(reinterpret_cast<char*>(entries.data()), entries.size() * sizeof(TransactionIndexEntry));
+        if (!file) {
+            Logger::getInstance().error("Failed to read transaction index: " + index_path);
+            return;
         }
         
-        return false;
+        locations.reserve(entries.size());
+        for (const auto& entry : entries) {
+            insertEntry(entry);
+            TransactionIdGenerator::observeExistingId(entry.transaction_id);
+        }
+        Logger::getInstance().info("Loaded transaction index with " + to_string(locations.size()) + " entries");
     }
     
-    bool authenticateWith2FA(int acc_no) {
-        if (!authenticate(acc_no)) {
-            return false;
+public:
+    static void setConfig(ConfigManager* cfg) { config = cfg; }
+    
+    static TransactionIdIndex& getInstance() {
+        static TransactionIdIndex instance;
+        return instance;
+    }
+    
+    TransactionIdIndex(const TransactionIdIndex&) = delete;
+    TransactionIdIndex& operator=(const TransactionIdIndex&) = delete;
+    
+    ~TransactionIdIndex() {
+        flush();
+    }
+    
+    void load() {
+        lock_guard<mutex> lock(index_mutex);
+        loadLocked();
+    }
+    
+    void add(uint64_t transaction_id, int account_no, uint64_t offset, uint32_t record_length) {
+        lock_guard<mutex> lock(index_mutex);
+        if (!loaded) {
+            loadLocked();
         }
-        
-        string otp = SecurityManager::generateOTP();
-        {
-            lock_guard<mutex> lock(auth_mutex);
-            active_otps[acc_no] = otp;
+        TransactionIndexEntry entry = {transaction_id, offset, account_no, record_length};
+        pending.push_back(entry);
+        insertEntry(entry);
+    }
+    
+    void addAll(const vector<TransactionIndexEntry>& entries) {
+        lock_guard<mutex> lock(index_mutex);
+        if (!loaded) {
+            loadLocked();
         }
-        
-        cout << "\n[DEMO] OTP sent to your registered phone: " << otp << endl;
-        cout << "Enter OTP: ";
-        
-        string entered_otp;
-        cin >> entered_otp;
-        
-        {
-            lock_guard<mutex> lock(auth_mutex);
-            if (active_otps[acc_no] == entered_otp) {
-                active_otps.erase(acc_no);
-                cout << "2FA authentication successful!" << endl;
-                Logger::getInstance().info("Successful 2FA authentication for account: " + to_string(acc_no));
-                return true;
-            } else {
-                cout << "Invalid OTP!" << endl;
-                Logger::getInstance().warning("Invalid OTP entered for account: " + to_string(acc_no));
-                return false;
-            }
+        for (const TransactionIndexEntry& entry : entries) {
+            pending.push_back(entry);
+            insertEntry(entry);
         }
     }
     
-    void unlockAccount(int acc_no) {
-        lock_guard<mutex> lock(auth_mutex);
-        failed_attempts[acc_no] = 0;
-        cout << "Account " << acc_no << " unlocked." << endl;
-        Logger::getInstance().info("Account " + to_string(acc_no) + " unlocked by admin");
+    bool flush() {
+        lock_guard<mutex> lock(index_mutex);
+        return flushLocked();
     }
     
-    void savePins() {
-        lock_guard<mutex> lock(auth_mutex);
-        string data_dir = config ? config->getString("directory.data", "data") : "data";
-        create_directories(data_dir);
-        
-        ofstream file(data_dir + "/pins_secure.dat");
-        if (file.is_open()) {
-            for (const auto& pair : account_pins) {
-                file << pair.first << "|" << pair.second.first << "|" << pair.second.second << endl;
-            }
-            file.close();
-            Logger::getInstance().debug("PIN data saved securely");
+    bool lookup(uint64_t transaction_id, Location& location) {
+        lock_guard<mutex> lock(index_mutex);
+        if (!loaded) {
+            loadLocked();
         }
+        auto it = locations.find(transaction_id);
+        if (it == locations.end()) return false;
+        location = it->second;
+        return true;
     }
     
-    void loadPins() {
-        lock_guard<mutex> lock(auth_mutex);
-        string data_dir = config ? config->getString("directory.data", "data") : "data";
+    size_t size() {
+        lock_guard<mutex> lock(index_mutex);
+        return locations.size();
+    }
+    
+    // Reads the indexed record straight from its account file.
+    bool fetch(uint64_t transaction_id, int& account_no, string& record) {
+        Location location;
+        if (!lookup(transaction_id, location)) return false;
+        
+        TransactionFileAppender::getInstance().flush(location.account_no);
+        ifstream file(TransactionFileAppender::pathFor(getDataDirectory(), location.account_no), ios::binary);
+        if (!file.is_open()) return false;
+        
+        record.assign(location.record_length, '\0');
+        file.seekg(static_cast<streamoff>(location.offset));
+        if (!file.read(&record[0], location.record_length)) return false;
+        if (TransactionIdGenerator::parse(record.substr(0, record.find('|'))) != transaction_id) {
+            Logger::getInstance().warning("Transaction index entry is stale for " + TransactionIdGenerator::format(transaction_id));
+            return false;
+        }
         
-        ifstream file(data_dir + "/pins_secure.dat");
-        if (!file.is_open()) {
-            Logger::getInstance().debug("No PIN data file found - starting fresh");
-            return;
+        account_no = location.account_no;
+        return true;
+    }
+    
+    // Rebuilds the index by scanning every transaction file in data_dir and
+    // replaces the on-disk index atomically. Returns the number of entries.
+    size_t rebuild() {
+        TransactionFileAppender::getInstance().flushAll();
+        lock_guard<mutex> lock(index_mutex);
+        
+        string data_dir = getDataDirectory();
+        vector<TransactionIndexEntry> entries;
+        
+        for (int account_no : TransactionFileAppender::listAccountFiles(data_dir)) {
+            ifstream file(TransactionFileAppender::pathFor(data_dir, account_no), ios::binary);
+            string line;
+            uint64_t offset = 0;
+            while (getline(file, line)) {
+                uint64_t line_offset = offset;
+                offset += line.size() + 1;
+                
+                size_t id_end = line.find('|');
+                uint64_t transaction_id = TransactionIdGenerator::parse(line.substr(0, id_end));
+                if (transaction_id == 0) continue;
+                
+                size_t record_length = line.size();
+                if (record_length > 0 && line[record_length - 1] == '\r') record_length--;
+                entries.push_back({transaction_id, line_offset, account_no, static_cast<uint32_t>(record_length)});
+            }
         }
         
-        string line;
-        while (getline(file, line)) {
-            if (line.empty()) continue;
-            
-            stringstream ss(line);
-            string acc_str, hash, salt;
-            
-            if (getline(ss, acc_str, '|') && getline(ss, hash, '|') && getline(ss, salt)) {
-                try {
-                    int acc_no = stoi(acc_str);
-                    account_pins[acc_no] = {hash, salt};
-                    failed_attempts[acc_no] = 0;
-                } catch (const exception& e) {
-                    Logger::getInstance().warning("Skipped corrupted PIN record: " + line);
-                    continue;
-                }
+        string index_file = indexPathFor(data_dir);
+        string temp_file = index_file + ".tmp";
+        {
+            ofstream out(temp_file, ios::binary | ios::trunc);
+            if (!out.is_open()) {
+                throw DataIntegrityException("Cannot write transaction index: " + temp_file);
+            }
+            out.write(reinterpret_cast<const char*>(entries.data()), entries.size() * sizeof(TransactionIndexEntry));
+            if (!out.good()) {
+                throw DataIntegrityException("Failed to write transaction index: " + temp_file);
             }
         }
-        file.close();
-        Logger::getInstance().info("Loaded PIN data for " + to_string(account_pins.size()) + " accounts");
+        filesystem::rename(temp_file, index_file);
+        
+        pending.clear();
+        locations.clear();
+        locations.reserve(entries.size());
+        for (const auto& entry : entries) {
+            insertEntry(entry);
+            TransactionIdGenerator::observeExistingId(entry.transaction_id);
+        }
+        index_path = index_file;
+        loaded = true;
+        
+        Logger::getInstance().info("Rebuilt transaction index with " + to_string(entries.size()) + " entries");
+        return entries.size();
     }
 };
 
-ConfigManager* AuthenticationManager::config = nullptr;
+ConfigManager* TransactionIdIndex::config = nullptr;
 
 // =============================================================================
-// ENHANCED FILE MANAGER WITH ATOMIC OPERATIONS (PRODUCTION FIX #3)
+// SPARSE PER-ACCOUNT TIMESTAMP INDEX
 // =============================================================================
+//
+// transactions_<acc>.idx holds (timestamp, offset) pairs, one for roughly
+// every transaction_log.time_index_interval_bytes of records. A date-range
+// read binary-searches the pairs and seeks straight to the last indexed
+// record before the range, instead of reading the file from the start.
+// Pairs are buffered per account and written at each commit, after the
+// records they point to.
 
-class FileManager {
+struct TimeIndexEntry {
+    int64_t timestamp;
+    uint64_t offset;
+};
+
+static_assert(sizeof(TimeIndexEntry) == 16, "Time index entries must stay 16 bytes");
+
+class TransactionTimeIndex {
 private:
+    struct AccountState {
+        uint64_t last_indexed_offset;
+        bool has_entries;
+        vector<TimeIndexEntry> pending;
+    };
+    
     static ConfigManager* config;
+    unordered_map<int, AccountState> states;
+    vector<int> accounts_with_pending;
+    string states_directory;
+    mutex index_mutex;
     
-public:
-    static void setConfig(ConfigManager* cfg) { config = cfg; }
+    TransactionTimeIndex() {}
     
-    static bool atomicSave(const string& filename, const std::function<void(ofstream&)>& write_function) {
-        string temp_filename = filename + ".tmp";
-        string backup_filename = filename + ".backup";
-        
-        try {
-            create_directories(path(filename).parent_path());
-            
-            ofstream temp_file(temp_filename, ios::binary);
-            if (!temp_file.is_open()) {
-                throw DataIntegrityException("Cannot create temporary file: " + temp_filename);
-            }
-            
-            write_function(temp_file);
-            temp_file.close();
-            
-            if (!temp_file.good()) {
-                throw DataIntegrityException("Failed to write to temporary file: " + temp_filename);
-            }
-            
-            if (exists(filename)) {
-                if (exists(backup_filename)) {
-                    remove(backup_filename);
-                }
-                rename(filename, backup_filename);
-            }
-            
-            rename(temp_filename, filename);
-            Logger::getInstance().debug("Atomic save completed for: " + filename);
-            return true;
-            
-        } catch (const exception& e) {
-            if (exists(temp_filename)) {
-                remove(temp_filename);
-            }
-            Logger::getInstance().error("Atomic save failed for " + filename + ": " + e.what());
-            return false;
+    static string getDataDirectory() {
+        return config ? config->snapshot().data_directory : "data";
+    }
+    
+    static string indexPathFor(const string& data_dir, int account_no) {
+        return data_dir + "/transactions_" + to_string(account_no) + ".idx";
+    }
+    
+    static uint64_t getInterval() {
+        int interval = config ? config->snapshot().time_index_interval_bytes : 4096;
+        return static_cast<uint64_t>(max(256, interval));
+    }
+    
+    static vector<TimeIndexEntry> readEntries(const string& path) {
+        vector<TimeIndexEntry> entries;
+        error_code ec;
+        uintmax_t file_size = filesystem::file_size(path, ec);
+        if (ec || file_size < sizeof(TimeIndexEntry)) return entries;
+        
+        entries.resize(file_size / sizeof(TimeIndexEntry));
+        ifstream file(path, ios::binary);
+        if (!file.read(reinterpret_cast<char*>(entries.data()), entries.size() * sizeof(TimeIndexEntry))) {
+            entries.clear();
         }
+        return entries;
     }
     
-    static void saveAllAccounts(const map<int, unique_ptr<Account>>& accounts) {
-        string data_dir = config ? config->getString("directory.data", "data") : "data";
-        create_directories(data_dir);
+    void writePending(const string& data_dir, int account_no, AccountState& state) {
+        if (state.pending.empty()) return;
+        
+        string path = indexPathFor(data_dir, account_no);
+        error_code ec;
+        uintmax_t file_size = filesystem::file_size(path, ec);
+        if (!ec && file_size % sizeof(TimeIndexEntry) != 0) {
+            filesystem::resize_file(path, file_size - file_size % sizeof(TimeIndexEntry), ec);
+        }
         
-        string filename = data_dir + "/accounts.dat";
-        
-        atomicSave(filename, [&accounts](ofstream& file) {
-            for (const auto& pair : accounts) {
-                const Account& account = *pair.second;
-                file << account.getAccountNumber() << "|"
-                     << account.getName() << "|"
-                     << account.getPhoneNumber() << "|"
-                     << account.getAddress() << "|"
-                     << account.getBalanceInPaise() << "|"
-                     << accountTypeToString(account.getAccountType()) << "|"
-                     << account.getCreatedDate();
-                
-                if (account.getAccountType() == AccountType::SAVINGS) {
-                    const SavingsAccount* savings_acc = dynamic_cast<const SavingsAccount*>(&account);
-                    if (savings_acc) {
-                        file << "|" << savings_acc->getInterestRate();
-                    }
-                } else if (account.getAccountType() == AccountType::CURRENT) {
-                    const CurrentAccount* current_acc = dynamic_cast<const CurrentAccount*>(&account);
-                    if (current_acc) {
-                        file << "|" << current_acc->getOverdraftLimitInPaise() << "|" << current_acc->getOverdraftCapInPaise();
-                    }
-                } else if (account.getAccountType() == AccountType::LOAN) {
-                    const LoanAccount* loan_acc = dynamic_cast<const LoanAccount*>(&account);
-                    if (loan_acc) {
-                        file << "|" << loan_acc->getPrincipalAmountInPaise() << "|" << loan_acc->getLoanInterestRate()
-                             << "|" << loan_acc->getTenureMonths() << "|" << loan_acc->getPaymentsMade();
-                    }
-                }
-                
-                file << endl;
+        ofstream file(path, ios::app | ios::binary);
+        file.write(reinterpret_cast<const char*>(state.pending.data()), state.pending.size() * sizeof(TimeIndexEntry));
+        if (!file.good()) {
+            Logger::getInstance().error("Failed to append time index for account " + to_string(account_no));
+        }
+        state.pending.clear();
+    }
+    
+    void flushLocked() {
+        for (int account_no : accounts_with_pending) {
+            auto it = states.find(account_no);
+            if (it != states.end()) {
+                writePending(states_directory, account_no, it->second);
             }
-        });
-        
-        Logger::getInstance().info("Saved " + to_string(accounts.size()) + " accounts to file");
+        }
+        accounts_with_pending.clear();
     }
     
-    static map<int, unique_ptr<Account>> loadAccounts() {
-        map<int, unique_ptr<Account>> accounts;
-        string data_dir = config ? config->getString("directory.data", "data") : "data";
-        string filename = data_dir + "/accounts.dat";
-        
-        ifstream file(filename);
-        if (!file.is_open()) {
-            Logger::getInstance().debug("No accounts file found - starting fresh");
-            return accounts;
+    AccountState& stateFor(int account_no) {
+        string data_dir = getDataDirectory();
+        if (data_dir != states_directory) {
+            flushLocked();
+            states.clear();
+            states_directory = data_dir;
         }
         
-        string line;
-        int loaded_count = 0;
-        while (getline(file, line)) {
-            if (line.empty()) continue;
-            
-            try {
-                stringstream ss(line);
-                vector<string> data;
-                string item;
-                
-                while (getline(ss, item, '|')) {
-                    data.push_back(item);
-                }
-                
-                if (data.size() >= 7) {
-                    int acc_no = stoi(data[0]);
-                    string name = data[1];
-                    string phone = data[2];
-                    string address = data[3];
-                    long long balance_paise = stoll(data[4]);
-                    AccountType type = stringToAccountType(data[5]);
-                    time_t created = (data.size() > 6) ? static_cast<time_t>(stoll(data[6])) : 0;
-                    
-                    unique_ptr<Account> account;
-                    
-                    if (type == AccountType::SAVINGS && data.size() >= 8) {
-                        auto savings_acc = make_unique<SavingsAccount>();
-                        savings_acc->setAccountDetails(acc_no, name, phone, address, balance_paise, created);
-                        savings_acc->setInterestRate(stof(data[7]));
-                        account = move(savings_acc);
-                    } else if (type == AccountType::CURRENT && data.size() >= 9) {
-                        auto current_acc = make_unique<CurrentAccount>();
-                        current_acc->setAccountDetails(acc_no, name, phone, address, balance_paise, created);
-                        current_acc->setOverdraftDetails(stoll(data[7]), stoll(data[8]));
-                        account = move(current_acc);
-                    } else if (type == AccountType::LOAN && data.size() >= 11) {
-                        auto loan_acc = make_unique<LoanAccount>();
-                        loan_acc->setAccountDetails(acc_no, name, phone, address, balance_paise, created);
-                        loan_acc->setLoanDetails(stoll(data[7]), stof(data[8]), stoi(data[9]), stoi(data[10]));
-                        account = move(loan_acc);
-                    }
-                    
-                    if (account) {
-                        accounts[acc_no] = move(account);
-                        loaded_count++;
-                    }
-                }
-            } catch (const exception& e) {
-                Logger::getInstance().warning("Skipped corrupted account record: " + line + 
-                                            " (Error: " + e.what() + ")");
-                continue;
-            }
+        auto it = states.find(account_no);
+        if (it != states.end()) return it->second;
+        
+        AccountState state = {0, false, {}};
+        string path = indexPathFor(data_dir, account_no);
+        vector<TimeIndexEntry> existing = readEntries(path);
+        
+        // Entries past the end of the records (an index written ahead of its
+        // data before a crash) are dropped so new appends are indexed again
+        error_code ec;
+        uintmax_t data_size = filesystem::file_size(TransactionFileAppender::pathFor(data_dir, account_no), ec);
+        if (ec) data_size = 0;
+        size_t valid = existing.size();
+        while (valid > 0 && existing[valid - 1].offset >= data_size) {
+            valid--;
+        }
+        if (valid < existing.size()) {
+            filesystem::resize_file(path, valid * sizeof(TimeIndexEntry), ec);
+            Logger::getInstance().warning("Time index for account " + to_string(account_no) + " pointed past its records - " + 
+                                         to_string(existing.size() - valid) + " entries dropped");
+            existing.resize(valid);
         }
-        file.close();
         
-        Logger::getInstance().info("Loaded " + to_string(loaded_count) + " accounts from file");
-        return accounts;
+        if (!existing.empty()) {
+            state.last_indexed_offset = existing.back().offset;
+            state.has_entries = true;
+        }
+        return states.emplace(account_no, move(state)).first->second;
     }
     
-    static void saveAllUsers(const map<string, User>& users) {
-        string data_dir = config ? config->getString("directory.data", "data") : "data";
-        create_directories(data_dir);
-        
-        string filename = data_dir + "/users_secure.dat";
-        
-        atomicSave(filename, [&users](ofstream& file) {
-            for (const auto& pair : users) {
-                file << pair.second.toDataString() << endl;
+public:
+    static void setConfig(ConfigManager* cfg) { config = cfg; }
+    
+    static TransactionTimeIndex& getInstance() {
+        static TransactionTimeIndex instance;
+        return instance;
+    }
+    
+    TransactionTimeIndex(const TransactionTimeIndex&) = delete;
+    TransactionTimeIndex& operator=(const TransactionTimeIndex&) = delete;
+    
+    ~TransactionTimeIndex() {
+        flush();
+    }
+    
+    struct Observation {
+        int account_no;
+        time_t timestamp;
+        uint64_t offset;
+    };
+    
+    // Called for every appended record; indexes one per interval.
+    void observe(int account_no, time_t timestamp, uint64_t offset) {
+        lock_guard<mutex> lock(index_mutex);
+        observeLocked(account_no, timestamp, offset);
+    }
+    
+    void observeAll(const vector<Observation>& observations) {
+        lock_guard<mutex> lock(index_mutex);
+        for (const Observation& observation : observations) {
+            observeLocked(observation.account_no, observation.timestamp, observation.offset);
+        }
+    }
+    
+private:
+    void observeLocked(int account_no, time_t timestamp, uint64_t offset) {
+        AccountState& state = stateFor(account_no);
+        if (!state.has_entries || offset >= state.last_indexed_offset + getInterval()) {
+            if (state.pending.empty()) {
+                accounts_with_pending.push_back(account_no);
             }
-        });
-        
-        Logger::getInstance().info("Saved " + to_string(users.size()) + " users to file");
+            state.pending.push_back({static_cast<int64_t>(timestamp), offset});
+            state.last_indexed_offset = offset;
+            state.has_entries = true;
+        }
     }
     
-    static map<string, User> loadUsers() {
-        map<string, User> users;
-        string data_dir = config ? config->getString("directory.data", "data") : "data";
-        string filename = data_dir + "/users_secure.dat";
-        
-        ifstream file(filename);
-        if (!file.is_open()) {
-            Logger::getInstance().debug("No users file found - starting fresh");
-            return users;
+public:
+    void flush() {
+        lock_guard<mutex> lock(index_mutex);
+        flushLocked();
+    }
+    
+    // Offset of the last indexed record stamped before from_time, or 0.
+    uint64_t findStartOffset(int account_no, time_t from_time) {
+        TransactionFileAppender::getInstance().flush(account_no);
+        string data_dir;
+        {
+            lock_guard<mutex> lock(index_mutex);
+            AccountState& state = stateFor(account_no);
+            writePending(states_directory, account_no, state);
+            data_dir = states_directory;
         }
         
+        vector<TimeIndexEntry> entries = readEntries(indexPathFor(data_dir, account_no));
+        auto first_not_before = lower_bound(entries.begin(), entries.end(), static_cast<int64_t>(from_time),
+            [](const TimeIndexEntry& entry, int64_t value) { return entry.timestamp < value; });
+        if (first_not_before == entries.begin()) return 0;
+        return prev(first_not_before)->offset;
+    }
+    
+    // Regenerates one account's index from its transaction file.
+    size_t rebuild(int account_no) {
+        lock_guard<mutex> lock(index_mutex);
+        string data_dir = getDataDirectory();
+        
+        ifstream file(TransactionFileAppender::pathFor(data_dir, account_no), ios::binary);
+        vector<TimeIndexEntry> entries;
         string line;
-        int loaded_count = 0;
+        uint64_t offset = 0;
+        uint64_t interval = getInterval();
         while (getline(file, line)) {
-            if (line.empty()) continue;
+            uint64_t line_offset = offset;
+            offset += line.size() + 1;
+            if (!entries.empty() && line_offset < entries.back().offset + interval) continue;
             
             try {
-                stringstream ss(line);
-                vector<string> data;
-                string item;
-                
-                while (getline(ss, item, '|')) {
-                    data.push_back(item);
-                }
-                
-                if (data.size() >= 6) {
-                    string username = data[0];
-                    string hashedPassword = data[1];
-                    string salt = data[2];
-                    UserRole role = static_cast<UserRole>(stoi(data[3]));
-                    time_t created = static_cast<time_t>(stoll(data[4]));
-                    time_t last_login = static_cast<time_t>(stoll(data[5]));
-                    
-                    vector<int> accounts;
-                    for (int i = 6; i < data.size(); i++) {
-                        accounts.push_back(stoi(data[i]));
-                    }
-                    
-                    User user;
-                    user.setUserDetails(username, hashedPassword, salt, accounts, role, created, last_login);
-                    users[username] = user;
-                    loaded_count++;
-                }
-            } catch (const exception& e) {
-                Logger::getInstance().warning("Skipped corrupted user record: " + line + 
-                                            " (Error: " + e.what() + ")");
-                continue;
+                entries.push_back({static_cast<int64_t>(Transaction::fromCSV(line).getTimestamp()), line_offset});
+            } catch (const exception&) {
+                // Unparseable lines are simply not indexed
             }
         }
-        file.close();
         
-        Logger::getInstance().info("Loaded " + to_string(loaded_count) + " users from file");
-        return users;
+        string path = indexPathFor(data_dir, account_no);
+        string temp_path = path + ".tmp";
+        {
+            ofstream out(temp_path, ios::binary | ios::trunc);
+            out.write(reinterpret_cast<const char*>(entries.data()), entries.size() * sizeof(TimeIndexEntry));
+            if (!out.good()) {
+                throw DataIntegrityException("Failed to write time index: " + temp_path);
+            }
+        }
+        filesystem::rename(temp_path, path);
+        
+        if (data_dir == states_directory) {
+            states.erase(account_no);
+        }
+        return entries.size();
     }
 };
 
-ConfigManager* FileManager::config = nullptr;
+ConfigManager* TransactionTimeIndex::config = nullptr;
 
 // =============================================================================
-// COMPLETE BANKING SYSTEM WITH TRANSACTION ROLLBACK (PRODUCTION FIX #4)
+// LIVE SYSTEM-WIDE AGGREGATES
 // =============================================================================
+//
+// Keeps the figures behind the statistics screen current so reading them is
+// O(1). Each account remembers the contribution it last published; a commit
+// publishes only the difference, so every path that changes an account
+// (including rollbacks and interest runs) is covered without per-operation
+// bookkeeping. Transaction counts by type are for this process; the
+// persisted total comes from the transaction-ID index.
 
-class BankingSystem {
+struct AggregateContribution {
+    long long savings_accounts = 0;
+    long long current_accounts = 0;
+    long long loan_accounts = 0;
+    long long deposits_paise = 0;
+    long long loans_paise = 0;
+    long long overdraft_used_paise = 0;
+    long long overdraft_cap_paise = 0;
+    
+    AggregateContribution& operator+=(const AggregateContribution& other) {
+        savings_accounts += other.savings_accounts;
+        current_accounts += other.current_accounts;
+        loan_accounts += other.loan_accounts;
+        deposits_paise += other.deposits_paise;
+        loans_paise += other.loans_paise;
+        overdraft_used_paise += other.overdraft_used_paise;
+        overdraft_cap_paise += other.overdraft_cap_paise;
+        return *this;
+    }
+    
+    AggregateContribution operator-(const AggregateContribution& other) const {
+        AggregateContribution delta = *this;
+        delta.savings_accounts -= other.savings_accounts;
+        delta.current_accounts -= other.current_accounts;
+        delta.loan_accounts -= other.loan_accounts;
+        delta.deposits_paise -= other.deposits_paise;
+        delta.loans_paise -= other.loans_paise;
+        delta.overdraft_used_paise -= other.overdraft_used_paise;
+        delta.overdraft_cap_paise -= other.overdraft_cap_paise;
+        return delta;
+    }
+};
+
+class SystemAggregates {
+public:
+    static constexpr size_t TRANSACTION_TYPE_COUNT = MetricCounters::TRANSACTION_TYPE_COUNT;
+    
+    struct Snapshot {
+        AggregateContribution totals;
+        array<uint64_t, TRANSACTION_TYPE_COUNT> transactions_by_type;
+    };
+    
 private:
-    map<int, unique_ptr<Account>> accounts;
-    map<string, User> users;
-    AuthenticationManager auth_manager;
-    string current_username;
-    ConfigManager* config;
-    TransactionManager transaction_manager;
+    atomic<long long> savings_accounts;
+    atomic<long long> current_accounts;
+    atomic<long long> loan_accounts;
+    atomic<long long> deposits_paise;
+    atomic<long long> loans_paise;
+    atomic<long long> overdraft_used_paise;
+    atomic<long long> overdraft_cap_paise;
     
-    User* getCurrentUser() {
-        if (current_username.empty()) return nullptr;
-        auto it = users.find(current_username);
-        return (it != users.end()) ? &it->second : nullptr;
+    SystemAggregates() : savings_accounts(0), current_accounts(0), loan_accounts(0), deposits_paise(0), 
+                         loans_paise(0), overdraft_used_paise(0), overdraft_cap_paise(0) {}
+    
+public:
+    static SystemAggregates& getInstance() {
+        static SystemAggregates instance;
+        return instance;
+    }
+    
+    SystemAggregates(const SystemAggregates&) = delete;
+    SystemAggregates& operator=(const SystemAggregates&) = delete;
+    
+    void apply(const AggregateContribution& delta) {
+        savings_accounts.fetch_add(delta.savings_accounts, memory_order_relaxed);
+        current_accounts.fetch_add(delta.current_accounts, memory_order_relaxed);
+        loan_accounts.fetch_add(delta.loan_accounts, memory_order_relaxed);
+        deposits_paise.fetch_add(delta.deposits_paise, memory_order_relaxed);
+        loans_paise.fetch_add(delta.loans_paise, memory_order_relaxed);
+        overdraft_used_paise.fetch_add(delta.overdraft_used_paise, memory_order_relaxed);
+        overdraft_cap_paise.fetch_add(delta.overdraft_cap_paise, memory_order_relaxed);
+    }
+    
+    // Counted per thread, since every recorded transaction passes through here
+    void countTransaction(TransactionType type) {
+        MetricCounters::countTransaction(type);
+    }
+    
+    Snapshot read() const {
+        Snapshot snapshot;
+        snapshot.totals.savings_accounts = savings_accounts.load(memory_order_relaxed);
+        snapshot.totals.current_accounts = current_accounts.load(memory_order_relaxed);
+        snapshot.totals.loan_accounts = loan_accounts.load(memory_order_relaxed);
+        snapshot.totals.deposits_paise = deposits_paise.load(memory_order_relaxed);
+        snapshot.totals.loans_paise = loans_paise.load(memory_order_relaxed);
+        snapshot.totals.overdraft_used_paise = overdraft_used_paise.load(memory_order_relaxed);
+        snapshot.totals.overdraft_cap_paise = overdraft_cap_paise.load(memory_order_relaxed);
+        snapshot.transactions_by_type = MetricCounters::transactionTotals();
+        return snapshot;
+    }
+};
+
+// =============================================================================
+// PROMETHEUS TEXTFILE EXPORTER
+// =============================================================================
+//
+// Every metrics.textfile_interval_ms, writes the process metrics in the
+// Prometheus text exposition format for node_exporter's textfile collector.
+// The file is written under a temporary name and renamed into place, so the
+// collector never reads a partial file. Counters are since process start.
+// Files are only written while a BankingSystem is open; a closing bank writes
+// its final state before releasing its accounts, and that file is left in
+// place rather than replaced by the empty totals that follow.
+
+class MetricsExporter {
+private:
+    ConfigManager& config;
+    atomic<bool> running;
+    thread exporter_thread;
+    mutex stop_mutex;
+    condition_variable stop_cv;
+    mutex write_mutex;
+    
+    static mutex registry_mutex;
+    static MetricsExporter* active_exporter;  // guarded by registry_mutex
+    static atomic<int> open_banks;
+    
+    static void writeMetric(ostream& out, const string& name, const string& type, const string& help) {
+        out << "# HELP " << name << " " << help << "\n";
+        out << "# TYPE " << name << " " << type << "\n";
+    }
+    
+    void exportLoop() {
+        while (running.load()) {
+            {
+                unique_lock<mutex> lock(stop_mutex);
+                int interval_ms = max(100, config.getInt("metrics.textfile_interval_ms", 15000));
+                if (stop_cv.wait_for(lock, chrono::milliseconds(interval_ms), [this]() { return !running.load(); })) {
+                    break;
+                }
+            }
+            writeNow();
+        }
     }
     
 public:
-    BankingSystem(ConfigManager* cfg) : config(cfg) {
-        accounts = FileManager::loadAccounts();
-        users = FileManager::loadUsers();
-        auth_manager.loadPins();
-        
-        int max_acc_no = config->getInt("account.starting_account_number", 100000);
-        for (const auto& pair : accounts) {
-            max_acc_no = max(max_acc_no, pair.first);
+    MetricsExporter(ConfigManager& cfg) : config(cfg), running(false) {}
+    
+    ~MetricsExporter() {
+        stop();
+    }
+    
+    string getPath() const {
+        string configured = config.getString("metrics.textfile_path", "");
+        return configured.empty() ? config.getString("directory.logs", "logs") + "/banking.prom" : configured;
+    }
+    
+    static string render() {
+        ostringstream out;
+        
+        array<uint64_t, MetricCounters::TRANSACTION_TYPE_COUNT> transactions = MetricCounters::transactionTotals();
+        writeMetric(out, "banking_transactions_total", "counter", "Transactions recorded, by type.");
+        for (size_t i = 0; i < transactions.size(); i++) {
+            out << "banking_transactions_total{type=\"" << transactionTypeToString(static_cast<TransactionType>(i)) 
+                << "\"} " << transactions[i] << "\n";
         }
-        AccountManager::setNextAccountNumber(max_acc_no);
         
-        Logger::getInstance().info("Banking system initialized - Loaded " + to_string(accounts.size()) + 
-                                  " accounts and " + to_string(users.size()) + " users");
+        writeMetric(out, "banking_transaction_rollbacks_total", "counter", "Transactions rolled back by the transaction manager.");
+        out << "banking_transaction_rollbacks_total " << MetricCounters::total(MetricCounter::TRANSACTION_ROLLBACKS) << "\n";
         
-        bool hasAdmin = false;
-        for (const auto& pair : users) {
-            if (pair.second.getRole() == UserRole::ADMIN) {
-                hasAdmin = true;
-                break;
-            }
-        }
+        writeMetric(out, "banking_atomic_saves_total", "counter", "Atomic file saves attempted.");
+        out << "banking_atomic_saves_total " << MetricCounters::total(MetricCounter::ATOMIC_SAVES) << "\n";
+        writeMetric(out, "banking_atomic_save_seconds_total", "counter", "Time spent in atomic file saves.");
+        out << "banking_atomic_save_seconds_total " << fixed << setprecision(9) 
+            << MetricCounters::total(MetricCounter::ATOMIC_SAVE_NANOSECONDS) / 1e9 << "\n";
         
-        if (!hasAdmin) {
-            User admin("admin", "admin123", UserRole::ADMIN);
-            users["admin"] = admin;
-            Logger::getInstance().info("Default admin user created (username: admin, password: admin123)");
-            cout << "🔐 Default admin user created (username: admin, password: admin123)" << endl;
+        Logger& logger = Logger::getInstance();
+        writeMetric(out, "banking_logger_queue_depth", "gauge", "Records waiting in the asynchronous log queue.");
+        out << "banking_logger_queue_depth " << logger.getQueueDepth() << "\n";
+        writeMetric(out, "banking_logger_dropped_lines_total", "counter", "Log records dropped because the queue was full.");
+        out << "banking_logger_dropped_lines_total " << logger.getDroppedCount() << "\n";
+        
+        writeMetric(out, "banking_pin_lockouts_total", "counter", "Accounts locked after too many failed PIN attempts.");
+        out << "banking_pin_lockouts_total " << MetricCounters::total(MetricCounter::PIN_LOCKOUTS) << "\n";
+        
+        SystemAggregates::Snapshot aggregates = SystemAggregates::getInstance().read();
+        const AggregateContribution& totals = aggregates.totals;
+        writeMetric(out, "banking_accounts", "gauge", "Accounts held in memory, by type.");
+        out << "banking_accounts{type=\"SAVINGS\"} " << totals.savings_accounts << "\n";
+        out << "banking_accounts{type=\"CURRENT\"} " << totals.current_accounts << "\n";
+        out << "banking_accounts{type=\"LOAN\"} " << totals.loan_accounts << "\n";
+        
+        writeMetric(out, "banking_deposits_paise", "gauge", "Total balance of savings and current accounts, in paise.");
+        out << "banking_deposits_paise " << totals.deposits_paise << "\n";
+        writeMetric(out, "banking_outstanding_loans_paise", "gauge", "Total outstanding loan balance, in paise.");
+        out << "banking_outstanding_loans_paise " << totals.loans_paise << "\n";
+        writeMetric(out, "banking_overdraft_used_paise", "gauge", "Overdraft currently drawn across current accounts, in paise.");
+        out << "banking_overdraft_used_paise " << totals.overdraft_used_paise << "\n";
+        return out.str();
+    }
+    
+    // Skipped while no bank is open, so a final snapshot is not overwritten.
+    bool writeNow() {
+        lock_guard<mutex> lock(write_mutex);
+        if (open_banks.load() == 0) {
+            return false;
         }
+        return writeLocked();
     }
     
-    ~BankingSystem() {
-        saveAllData();
+    // BankingSystem brackets its lifetime with these.
+    static void bankOpened() {
+        open_banks.fetch_add(1);
     }
     
-    void saveAllData() {
-        FileManager::saveAllAccounts(accounts);
-        FileManager::saveAllUsers(users);
-        auth_manager.savePins();
-        Logger::getInstance().info("All banking system data saved successfully");
-        cout << "💾 All data saved securely." << endl;
-    }
-    
-    bool userLogin() {
-        cout << "\n=== SECURE USER LOGIN ===" << endl;
-        cout << "1. Login to existing account" << endl;
-        cout << "2. Create new user account" << endl;
-        cout << "3. Continue as guest (limited access)" << endl;
-        
-        int choice = InputValidator::getValidChoice("Enter choice: ", 1, 3);
-        
-        if (choice == 3) {
-            current_username.clear();
-            cout << "Continuing in guest mode (limited access)" << endl;
-            Logger::getInstance().info("User continued in guest mode");
-            return true;
-        }
-        
-        if (choice == 2) {
-            return createNewUser();
+    static void bankClosing() {
+        lock_guard<mutex> registry(registry_mutex);
+        if (active_exporter) {
+            lock_guard<mutex> lock(active_exporter->write_mutex);
+            active_exporter->writeLocked();
+            open_banks.fetch_sub(1);
         } else {
-            return authenticateUser();
+            open_banks.fetch_sub(1);
         }
     }
     
-    bool createNewUser() {
-        string username = InputValidator::getValidString("Enter new username: ");
+private:
+    // Caller holds write_mutex.
+    bool writeLocked() {
+        string target = getPath();
+        string temp_file = target + ".tmp";
+        error_code ec;
+        create_directories(path(target).parent_path(), ec);
         
-        if (users.find(username) != users.end()) {
-            cout << "Username already exists!" << endl;
-            return false;
+        {
+            ofstream out(temp_file, ios::trunc);
+            if (!out.is_open()) {
+                Logger::getInstance().warning("Cannot write metrics file " + temp_file);
+                return false;
+            }
+            out << render();
+            if (!out.good()) {
+                return false;
+            }
         }
-        
-        string password = InputValidator::getValidString("Enter password (min " + 
-            to_string(config->getInt("security.min_password_length", 6)) + " characters): ");
-        
-        if (!SecurityManager::isValidPassword(password)) {
-            cout << "Password too short! Minimum length: " << config->getInt("security.min_password_length", 6) << endl;
+        rename(temp_file, target, ec);
+        if (ec) {
+            Logger::getInstance().warning("Cannot publish metrics file " + target + ": " + ec.message());
             return false;
         }
-        
-        User new_user(username, password);
-        users[username] = new_user;
-        current_username = username;
-        
-        cout << "✅ User account created successfully!" << endl;
         return true;
     }
     
-    bool authenticateUser() {
-        string username = InputValidator::getValidString("Enter username: ");
+public:
+    // An interval of 0 or less disables the exporter.
+    void start() {
+        if (config.getInt("metrics.textfile_interval_ms", 15000) <= 0) return;
+        if (running.exchange(true)) return;
+        {
+            lock_guard<mutex> registry(registry_mutex);
+            active_exporter = this;
+        }
+        exporter_thread = thread([this]() { exportLoop(); });
+        Logger::getInstance().info("Writing Prometheus metrics to " + getPath());
+    }
+    
+    // Writes a final snapshot if a bank is still open.
+    void stop() {
+        {
+            lock_guard<mutex> lock(stop_mutex);
+            if (!running.exchange(false)) return;
+        }
+        {
+            lock_guard<mutex> registry(registry_mutex);
+            active_exporter = nullptr;
+        }
+        stop_cv.notify_all();
+        if (exporter_thread.joinable()) {
+            exporter_thread.join();
+        }
+        writeNow();
+    }
+};
+
+mutex MetricsExporter::registry_mutex;
+MetricsExporter* MetricsExporter::active_exporter = nullptr;
+atomic<int> MetricsExporter::open_banks{0};
+
+// =============================================================================
+// ENHANCED BASE ACCOUNT CLASS WITH MONETARY PRECISION
+// =============================================================================
+
+class Account {
+protected:
+    int acc_no;
+    string phone_number;
+    string name;
+    string address;
+    long long balance_in_paise;
+    mutable CircularBuffer<Transaction> transaction_history;
+    mutable bool history_loaded = false;
+    time_t created_date_utc;
+    // Set whenever the persisted record would change; cleared by the
+    // checkpoint that writes it. New accounts start dirty.
+    bool dirty = true;
+    // Set when the WAL holds this account's latest state; any later change
+    // that bypasses the WAL (month-end interest) clears it again.
+    bool wal_logged = false;
+    // What this account last contributed to SystemAggregates.
+    AggregateContribution published_contribution;
+    static ConfigManager* config;
+    
+    void markDirty() {
+        dirty = true;
+        wal_logged = false;
+    }
+    
+    int getMaxHistoryLimit() const {
+        return config ? config->snapshot().max_history_per_account : 500;
+    }
+
+public:
+    static void setConfig(ConfigManager* cfg) { config = cfg; }
+    
+    virtual void getAccountInfo() {
+        cout << "\nAccount Creation Options:" << endl;
+        cout << "1. Auto-generate account number" << endl;
+        cout << "2. Choose your own account number" << endl;
+        int choice = InputValidator::getValidChoice("Enter choice: ", 1, 2);
         
-        if (users.find(username) == users.end()) {
-            cout << "❌ Username not found!" << endl;
-            return false;
+        if (choice == 1) {
+            acc_no = AccountManager::generateUniqueAccountNumber();
+            cout << "Auto-generated Account Number: " << acc_no << endl;
+            Logger::getInstance().info("Auto-generated account number: " + to_string(acc_no));
+        } else {
+            acc_no = InputValidator::getValidAccountNumber("Enter Account number: ");
         }
         
-        string password = InputValidator::getValidString("Enter password: ");
+        name = InputValidator::getValidString("Enter Name: ");
+        phone_number = InputValidator::getValidPhoneNumber("Enter Phone Number (10 digits): ");
+        address = InputValidator::getValidString("Enter Address: ");
+        balance_in_paise = InputValidator::getValidAmountInPaise("Enter Initial Balance: Rs. ");
         
-        if (users[username].authenticate(password)) {
-            current_username = username;
-            cout << "✅ Login successful! Welcome " << username << endl;
-            
-            time_t last_login = users[username].getLastLogin();
-            if (last_login > 0) {
-                cout << "📅 Last login: " << TimeUtils::formatTimestampUTC(last_login) << endl;
-            }
-            
-            return true;
-        } else {
-            cout << "❌ Invalid password!" << endl;
-            return false;
+        created_date_utc = TimeUtils::getCurrentUTC();
+        history_loaded = true;
+        recordTransaction(TransactionType::ACCOUNT_CREATED, balance_in_paise, "Account opened with initial deposit");
+        
+        Logger::getInstance().info("Account created: " + to_string(acc_no) + " for " + name);
+    }
+
+    virtual void displayAccountInfo() const {
+        cout << "\n--- Account Details ---";
+        cout << "\nAccount No. : " << acc_no;
+        cout << "\nName        : " << name;
+        cout << "\nPhone No.   : " << phone_number;
+        cout << "\nAddress     : " << address;
+        cout << "\nBalance     : " << MoneyUtils::formatCurrency(balance_in_paise);
+        cout << "\nCreated     : " << TimeUtils::formatTimestampUTC(created_date_utc);
+        cout << "\nAccount Type: " << accountTypeToString(getAccountType());
+    }
+
+    // Every balance-changing operation records a transaction, so this is where
+    // credits, debits, overdraft use and loan payments mark the record dirty.
+    void recordTransaction(TransactionType type, long long amount_paise, const string& description = "") {
+        Transaction trans = recordUnsavedTransaction(type, amount_paise, description);
+        saveTransactionToFile(trans);
+        Logger::getInstance().info("Transaction recorded - Account: " + to_string(acc_no) + 
+                                  ", Type: " + transactionTypeToString(type) + 
+                                  ", Amount: " + MoneyUtils::formatCurrency(amount_paise));
+    }
+    
+    // Records a transaction in memory only; the caller writes it to the
+    // transaction file.
+    Transaction recordUnsavedTransaction(TransactionType type, long long amount_paise, const string& description = "") {
+        markDirty();
+        SystemAggregates::getInstance().countTransaction(type);
+        ensureHistoryLoaded();
+        Transaction trans(type, amount_paise, balance_in_paise, description);
+        transaction_history.setCapacity(getMaxHistoryLimit());
+        transaction_history.push_back(trans);
+        return trans;
+    }
+    
+    bool canDebit(long long amount_paise) const {
+        return amount_paise <= balance_in_paise;
+    }
+    
+    TxnStatus tryCredit(long long amount_paise) {
+        ScopedLatency latency(LatencyMetric::ACCOUNT_CREDIT);
+        balance_in_paise = MoneyUtils::addMoney(balance_in_paise, amount_paise);
+        recordTransaction(TransactionType::CREDIT, amount_paise);
+        return TxnStatus::OK;
+    }
+    
+    TxnStatus tryDebit(long long amount_paise) {
+        ScopedLatency latency(LatencyMetric::ACCOUNT_DEBIT);
+        if (!canDebit(amount_paise)) {
+            return TxnStatus::INSUFFICIENT_FUNDS;
         }
+        balance_in_paise = MoneyUtils::subtractMoney(balance_in_paise, amount_paise);
+        recordTransaction(TransactionType::DEBIT, amount_paise);
+        return TxnStatus::OK;
     }
     
-    void createAccount(AccountType type) {
-        unique_ptr<Account> new_account;
+    void credit(long long amount_paise) {
+        tryCredit(amount_paise);
+    }
+    
+    void debit(long long amount_paise) {
+        if (tryDebit(amount_paise) != TxnStatus::OK) {
+            throw InsufficientFundsException("Cannot debit " + MoneyUtils::formatCurrency(amount_paise) + 
+                                           " from account " + to_string(acc_no) + 
+                                           ". Available balance: " + MoneyUtils::formatCurrency(balance_in_paise));
+        }
+    }
+    
+    void showTransactionHistory(int limit = 10, TransactionType filter_type = static_cast<TransactionType>(-1)) const {
+        cout << "\n=== TRANSACTION HISTORY ===" << endl;
+        cout << left << setw(24) << "TXN ID"
+             << setw(18) << "TYPE"
+             << setw(15) << "AMOUNT"
+             << setw(15) << "BALANCE"
+             << setw(25) << "TIMESTAMP (UTC)"
+             << "DESCRIPTION" << endl;
+        cout << string(122, '-') << endl;
         
-        switch (type) {
-            case AccountType::SAVINGS:
-                new_account = make_unique<SavingsAccount>();
-                break;
-            case AccountType::CURRENT:
-                new_account = make_unique<CurrentAccount>();
-                break;
-            case AccountType::LOAN:
-                new_account = make_unique<LoanAccount>();
-                break;
-            default:
-                cout << "❌ Invalid account type!" << endl;
-                return;
+        ensureHistoryLoaded();
+        if (transaction_history.empty()) {
+            cout << "No transactions found." << endl;
+            return;
         }
         
-        int acc_no;
-        do {
-            new_account->getAccountInfo();
-            acc_no = new_account->getAccountNumber();
-            
-            if (accounts.find(acc_no) != accounts.end()) {
-                cout << "⚠️ Account number " << acc_no << " already exists!" << endl;
-                cout << "Please choose a different number or use auto-generation." << endl;
+        // Walk newest-first, keeping pointers to the newest `limit` matches
+        vector<const Transaction*> newest_matches;
+        int match_count = 0;
+        for (auto it = transaction_history.rbegin(); it != transaction_history.rend(); ++it) {
+            if (filter_type == static_cast<TransactionType>(-1) || it->getType() == filter_type) {
+                if (match_count < limit) {
+                    newest_matches.push_back(&*it);
+                }
+                match_count++;
             }
-        } while (accounts.find(acc_no) != accounts.end());
-        
-        auth_manager.registerPin(acc_no);
-        
-        User* current_user = getCurrentUser();
-        if (current_user) {
-            current_user->addAccount(acc_no);
         }
         
-        accounts[acc_no] = move(new_account);
-        cout << "\n🎉 " << accountTypeToString(type) << " Account Created Successfully!" << endl;
+        for (auto it = newest_matches.rbegin(); it != newest_matches.rend(); ++it) {
+            (*it)->display();
+        }
         
-        saveAllData();
+        cout << "Showing " << min(limit, match_count) 
+             << " of " << match_count << " transactions" << endl;
     }
     
-    Account* findAccount(int acc_no) {
-        auto it = accounts.find(acc_no);
-        return (it != accounts.end()) ? it->second.get() : nullptr;
+    void generateAccountStatement() const {
+        cout << "\n=== ACCOUNT STATEMENT ===" << endl;
+        displayAccountInfo();
+        showTransactionHistory(50);
     }
     
-    bool canAccessAccount(int acc_no) {
-        User* current_user = getCurrentUser();
-        if (!current_user) {
-            return false;
+    void saveTransactionToFile(const Transaction& trans) const {
+        string record = trans.toCSV();
+        uint64_t offset = TransactionFileAppender::getInstance().append(acc_no, record);
+        if (offset != TransactionFileAppender::NO_OFFSET) {
+            TransactionIdIndex::getInstance().add(trans.getTransactionId(), acc_no, offset, 
+                                                  static_cast<uint32_t>(record.size()));
+            TransactionTimeIndex::getInstance().observe(acc_no, trans.getTimestamp(), offset);
         }
-        return current_user->ownsAccount(acc_no) || current_user->isAdmin();
     }
     
-    void transferMoney() {
-        cout << "\n=== 💸 SECURE MONEY TRANSFER ===" << endl;
+    // Reads every record stamped within [from_time, to_time] straight from
+    // the transaction file, including records beyond the in-memory cap.
+    vector<Transaction> getTransactionsInRange(time_t from_time, time_t to_time) const {
+        vector<Transaction> matches;
+        TransactionFileAppender::getInstance().flush(acc_no);
+        
+        string data_dir = config ? config->snapshot().data_directory : "data";
+        ifstream file(TransactionFileAppender::pathFor(data_dir, acc_no), ios::binary);
+        if (!file.is_open()) return matches;
+        
+        uint64_t start_offset = TransactionTimeIndex::getInstance().findStartOffset(acc_no, from_time);
+        if (start_offset > 0) {
+            // The indexed offset must begin a line; otherwise fall back to a full scan
+            char preceding = '\0';
+            file.seekg(static_cast<streamoff>(start_offset - 1));
+            if (!file.get(preceding) || preceding != '\n') {
+                Logger::getInstance().warning("Time index for account " + to_string(acc_no) + " is stale - scanning from start");
+                file.clear();
+                file.seekg(0);
+            }
+        }
         
-        User* current_user = getCurrentUser();
-        if (!current_user) {
-            cout << "❌ Please login to perform transfers." << endl;
-            return;
+        string line;
+        while (getline(file, line)) {
+            if (line.empty()) continue;
+            try {
+                Transaction transaction = Transaction::fromCSV(line);
+                if (transaction.getTimestamp() > to_time) break;
+                if (transaction.getTimestamp() >= from_time) {
+                    matches.push_back(transaction);
+                }
+            } catch (const exception&) {
+                Logger::getInstance().warning("Skipping malformed transaction record for account " + to_string(acc_no));
+            }
         }
+        return matches;
+    }
+    
+    void showStatementForRange(time_t from_time, time_t to_time) const {
+        vector<Transaction> matches = getTransactionsInRange(from_time, to_time);
         
-        int from_acc = InputValidator::getValidAccountNumber("Enter source account number: ");
-        Account* source = findAccount(from_acc);
+        cout << "\n=== STATEMENT " << TimeUtils::formatTimestampUTC(from_time) << " - " 
+             << TimeUtils::formatTimestampUTC(to_time) << " ===" << endl;
+        cout << "Account: " << acc_no << " (" << name << ")" << endl;
+        cout << left << setw(24) << "TXN ID"
+             << setw(18) << "TYPE"
+             << setw(15) << "AMOUNT"
+             << setw(15) << "BALANCE"
+             << setw(25) << "TIMESTAMP (UTC)"
+             << "DESCRIPTION" << endl;
+        cout << string(122, '-') << endl;
         
-        if (!source) {
-            cout << "❌ Source account not found!" << endl;
+        if (matches.empty()) {
+            cout << "No transactions in this period." << endl;
             return;
         }
         
-        if (!canAccessAccount(from_acc)) {
-            cout << "❌ You don't have access to this account!" << endl;
-            return;
+        for (const auto& transaction : matches) {
+            transaction.display();
         }
+        cout << string(122, '-') << endl;
+        cout << "Transactions: " << matches.size() << endl;
+        cout << "Closing balance: " << MoneyUtils::formatCurrency(matches.back().getBalanceAfterInPaise()) << endl;
+    }
+    
+    // Loads only the newest max_history_per_account records by reading the
+    // transaction file backwards from the end in fixed-size chunks.
+    void loadTransactionHistory() const {
+        TransactionFileAppender::getInstance().flush(acc_no);
+        history_loaded = true;
         
-        if (!auth_manager.authenticateWith2FA(from_acc)) {
+        string data_dir = config ? config->snapshot().data_directory : "data";
+        string filename = data_dir + "/transactions_" + to_string(acc_no) + ".txt";
+        
+        ifstream file(filename, ios::binary | ios::ate);
+        if (!file.is_open()) {
+            Logger::getInstance().debug("No transaction history found for account: " + to_string(acc_no));
             return;
         }
         
-        int to_acc = InputValidator::getValidAccountNumber("Enter destination account number: ");
-        Account* destination = findAccount(to_acc);
+        const size_t max_records = static_cast<size_t>(max(1, getMaxHistoryLimit()));
+        const streamoff chunk_size = 64 * 1024;
+        streamoff position = file.tellg();
+        size_t newlines_seen = 0;
+        vector<string> chunks;
         
-        if (!destination) {
-            cout << "❌ Destination account not found!" << endl;
-            return;
+        // One extra newline marks the start of the oldest wanted record
+        while (position > 0 && newlines_seen <= max_records) {
+            streamoff read_size = min(chunk_size, position);
+            position -= read_size;
+            
+            string chunk(static_cast<size_t>(read_size), '\0');
+            file.seekg(position);
+            file.read(&chunk[0], read_size);
+            newlines_seen += count(chunk.begin(), chunk.end(), '\n');
+            chunks.push_back(move(chunk));
         }
+        file.close();
         
-        if (from_acc == to_acc) {
-            cout << "❌ Cannot transfer to the same account!" << endl;
-            return;
+        string tail;
+        for (auto it = chunks.rbegin(); it != chunks.rend(); ++it) {
+            tail += *it;
         }
         
-        // BEGIN TRANSACTION WITH ROLLBACK CAPABILITY (PRODUCTION FIX #4)
-        transaction_manager.beginTransaction();
-        
-        try {
-            long long amount_paise = InputValidator::getValidAmountInPaise("Enter transfer amount: Rs. ");
+        vector<string> lines;
+        stringstream ss(tail);
+        string line;
+        bool skip_partial = (position > 0);
+        while (getline(ss, line)) {
+            if (skip_partial) {
+                skip_partial = false;
+                continue;
+            }
+            if (!line.empty()) {
+                lines.push_back(line);
+            }
+        }
+        
+        size_t first = lines.size() > max_records ? lines.size() - max_records : 0;
+        transaction_history.clear();
+        transaction_history.setCapacity(max_records);
+        transaction_history.reserve(lines.size() - first);
+        for (size_t i = first; i < lines.size(); i++) {
+            try {
+                transaction_history.push_back(Transaction::fromCSV(lines[i]));
+            } catch (const exception& e) {
+                Logger::getInstance().warning("Skipped corrupted transaction record for account " + 
+                                            to_string(acc_no) + ": " + e.what());
+            }
+        }
+        Logger::getInstance().info("Loaded " + to_string(transaction_history.size()) + 
+                                  " transactions for account " + to_string(acc_no));
+    }
+    
+    // History is loaded on first use instead of at startup.
+    void ensureHistoryLoaded() const {
+        if (!history_loaded) {
+            loadTransactionHistory();
+        }
+    }
+    
+    // Getters
+    int getAccountNumber() const { return acc_no; }
+    string getName() const { return name; }
+    string getPhoneNumber() const { return phone_number; }
+    string getAddress() const { return address; }
+    long long getBalanceInPaise() const { return balance_in_paise; }
+    double getBalanceInRupees() const { return MoneyUtils::paiseToRupees(balance_in_paise); }
+    virtual AccountType getAccountType() const = 0;
+    const CircularBuffer<Transaction>& getTransactionHistory() const {
+        ensureHistoryLoaded();
+        return transaction_history;
+    }
+    time_t getCreatedDate() const { return created_date_utc; }
+    bool isDirty() const { return dirty; }
+    void clearDirty() {
+        dirty = false;
+        wal_logged = false;
+    }
+    bool isWalLogged() const { return wal_logged; }
+    void markWalLogged() { wal_logged = true; }
+    
+    virtual AggregateContribution currentContribution() const {
+        AggregateContribution contribution;
+        switch (getAccountType()) {
+            case AccountType::SAVINGS:
+                contribution.savings_accounts = 1;
+                contribution.deposits_paise = balance_in_paise;
+                break;
+            case AccountType::CURRENT:
+                contribution.current_accounts = 1;
+                contribution.deposits_paise = balance_in_paise;
+                break;
+            case AccountType::LOAN:
+                contribution.loan_accounts = 1;
+                contribution.loans_paise = balance_in_paise;
+                break;
+            default:
+                break;
+        }
+        return contribution;
+    }
+    
+    // Returns the change since the last call and records the new baseline.
+    // Callers hold the account lock and apply the delta to SystemAggregates.
+    AggregateContribution takeAggregateDelta() {
+        AggregateContribution current = currentContribution();
+        AggregateContribution delta = current - published_contribution;
+        published_contribution = current;
+        return delta;
+    }
+    
+    void publishAggregates() {
+        SystemAggregates::getInstance().apply(takeAggregateDelta());
+    }
+    
+    void setAccountDetails(int acc, const string& n, const string& ph, const string& addr, 
+                          long long bal_paise, time_t created = 0) {
+        acc_no = acc;
+        name = n;
+        phone_number = ph;
+        address = addr;
+        balance_in_paise = bal_paise;
+        created_date_utc = (created == 0) ? TimeUtils::getCurrentUTC() : created;
+        
+        AccountManager::observeAccountNumber(acc);
+        
+        transaction_history.clear();
+        history_loaded = false;
+        markDirty();
+    }
+    
+    void setBalanceInPaise(long long paise) {
+        balance_in_paise = paise;
+        markDirty();
+    }
+
+    // Non-interactive business operations shared by the menu and batch paths.
+    // A declined try* call leaves the account untouched.
+    virtual TxnStatus tryDeposit(long long amount_paise) = 0;
+    virtual TxnStatus tryWithdraw(long long amount_paise) = 0;
+    
+    void deposit(long long amount_paise) {
+        TxnStatus status = tryDeposit(amount_paise);
+        if (status != TxnStatus::OK) {
+            throwTxnStatus(status, "Cannot deposit " + MoneyUtils::formatCurrency(amount_paise) + 
+                                   " to account " + to_string(acc_no) + " (" + txnStatusToString(status) + ")");
+        }
+    }
+    
+    void withdraw(long long amount_paise) {
+        TxnStatus status = tryWithdraw(amount_paise);
+        if (status != TxnStatus::OK) {
+            throwTxnStatus(status, "Cannot withdraw " + MoneyUtils::formatCurrency(amount_paise) + 
+                                   " from account " + to_string(acc_no) + " (" + txnStatusToString(status) + 
+                                   "). Available balance: " + MoneyUtils::formatCurrency(balance_in_paise));
+        }
+    }
+    
+    virtual void processWithdrawal() = 0;
+    virtual void processDeposit() = 0;
+    virtual ~Account() {
+        // Withdraw whatever this account still contributes to the live totals
+        SystemAggregates::getInstance().apply(AggregateContribution() - published_contribution);
+    }
+};
+
+ConfigManager* Account::config = nullptr;
+
+// =============================================================================
+// ENHANCED SAVINGS ACCOUNT CLASS WITH PRECISE MONETARY CALCULATIONS
+// =============================================================================
+
+class SavingsAccount : public Account {
+protected:
+    float interest_rate;
+
+public:
+    void getAccountInfo() override {
+        Account::getAccountInfo();
+        
+        float min_rate = config ? config->getFloat("savings.min_interest_rate", 0.1f) : 0.1f;
+        float max_rate = config ? config->getFloat("savings.max_interest_rate", 15.0f) : 15.0f;
+        
+        cout << "Enter rate of interest (" << min_rate << "-" << max_rate << "%): ";
+        do {
+            cin >> interest_rate;
+            if (interest_rate < min_rate || interest_rate > max_rate) {
+                cout << "Interest rate must be between " << min_rate << "% and " << max_rate << "%. Try again: ";
+            }
+        } while (interest_rate < min_rate || interest_rate > max_rate);
+        
+        Logger::getInstance().info("Savings account created with " + to_string(interest_rate) + "% interest rate");
+    }
+
+    TxnStatus tryWithdraw(long long amount_paise) override {
+        if (!canDebit(amount_paise)) {
+            return TxnStatus::INSUFFICIENT_FUNDS;
+        }
+        
+        balance_in_paise = MoneyUtils::subtractMoney(balance_in_paise, amount_paise);
+        recordTransaction(TransactionType::WITHDRAWAL, amount_paise, "ATM/Branch withdrawal");
+        return TxnStatus::OK;
+    }
+    
+    TxnStatus tryDeposit(long long amount_paise) override {
+        balance_in_paise = MoneyUtils::addMoney(balance_in_paise, amount_paise);
+        recordTransaction(TransactionType::DEPOSIT, amount_paise, "Cash/Cheque deposit");
+        return TxnStatus::OK;
+    }
+
+    void processWithdrawal() override {
+        try {
+            long long amount_paise = InputValidator::getValidAmountInPaise("\nEnter amount to withdraw: Rs. ");
+            if (tryWithdraw(amount_paise) != TxnStatus::OK) {
+                cout << "\nTransaction declined: insufficient funds. Available balance: " 
+                     << MoneyUtils::formatCurrency(balance_in_paise) << endl;
+                return;
+            }
+            cout << "\nWithdrawal successful! New balance: " << MoneyUtils::formatCurrency(balance_in_paise) << endl;
+            
+        } catch (const BankingException& e) {
+            cout << "\nTransaction failed: " << e.what() << endl;
+        }
+    }
+
+    void processDeposit() override {
+        try {
+            long long amount_paise = InputValidator::getValidAmountInPaise("\nEnter amount to deposit: Rs. ");
+            deposit(amount_paise);
+            cout << "\nDeposit successful! New balance: " << MoneyUtils::formatCurrency(balance_in_paise) << endl;
+            
+        } catch (const exception& e) {
+            cout << "\nDeposit failed: " << e.what() << endl;
+            Logger::getInstance().error("Deposit failed for account " + to_string(acc_no) + ": " + e.what());
+        }
+    }
+
+    long long calculateInterestInPaise() const {
+        return MoneyUtils::calculatePercentage(balance_in_paise, interest_rate);
+    }
+    
+    long long creditMonthlyInterest() {
+        long long interest_paise = calculateInterestInPaise();
+        balance_in_paise = MoneyUtils::addMoney(balance_in_paise, interest_paise);
+        recordTransaction(TransactionType::INTEREST_APPLIED, interest_paise, "Monthly interest credited");
+        return interest_paise;
+    }
+    
+    // As creditMonthlyInterest, but returns the INTEREST_APPLIED record for
+    // the caller to write.
+    Transaction postMonthlyInterest() {
+        long long interest_paise = calculateInterestInPaise();
+        balance_in_paise = MoneyUtils::addMoney(balance_in_paise, interest_paise);
+        return recordUnsavedTransaction(TransactionType::INTEREST_APPLIED, interest_paise, "Monthly interest credited");
+    }
+    
+    void applyMonthlyInterest() {
+        long long interest_paise = creditMonthlyInterest();
+        cout << "Monthly interest of " << MoneyUtils::formatCurrency(interest_paise) 
+             << " applied to account " << acc_no << endl;
+        
+        Logger::getInstance().info("Interest applied - Account: " + to_string(acc_no) + 
+                                  ", Amount: " + MoneyUtils::formatCurrency(interest_paise));
+    }
+
+    void displayAccountInfo() const override {
+        Account::displayAccountInfo();
+        cout << "\nInterest Rate : " << fixed << setprecision(1) << interest_rate << "%";
+        cout << "\nInterest to be Earned: " << MoneyUtils::formatCurrency(calculateInterestInPaise()) << endl;
+    }
+    
+    AccountType getAccountType() const override {
+        return AccountType::SAVINGS;
+    }
+    
+    float getInterestRate() const { return interest_rate; }
+    void setInterestRate(float rate) { 
+        interest_rate = rate; 
+        markDirty();
+    }
+};
+
+// =============================================================================
+// ENHANCED CURRENT ACCOUNT CLASS WITH PRECISE OVERDRAFT HANDLING
+// =============================================================================
+
+class CurrentAccount : public Account {
+protected:
+    long long overdraft_limit_paise;
+    long long overdraft_cap_paise;
+
+public:
+    void getAccountInfo() override {
+        Account::getAccountInfo();
+        overdraft_limit_paise = InputValidator::getValidAmountInPaise("Enter Overdraft Limit: Rs. ");
+        overdraft_cap_paise = overdraft_limit_paise;
+        Logger::getInstance().info("Current account created with " + MoneyUtils::formatCurrency(overdraft_limit_paise) + " overdraft limit");
+    }
+
+    TxnStatus tryWithdraw(long long amount_paise) override {
+        if (amount_paise > (balance_in_paise + overdraft_limit_paise)) {
+            return TxnStatus::INSUFFICIENT_FUNDS;
+        }
+        
+        if (amount_paise > balance_in_paise) {
+            long long from_overdraft = amount_paise - balance_in_paise;
+            balance_in_paise = 0;
+            overdraft_limit_paise = MoneyUtils::subtractMoney(overdraft_limit_paise, from_overdraft);
+            recordTransaction(TransactionType::OVERDRAFT_WITHDRAWAL, amount_paise, 
+                            "Withdrawal using overdraft facility");
+        } else {
+            balance_in_paise = MoneyUtils::subtractMoney(balance_in_paise, amount_paise);
+            recordTransaction(TransactionType::WITHDRAWAL, amount_paise, "Regular withdrawal");
+        }
+        return TxnStatus::OK;
+    }
+    
+    TxnStatus tryDeposit(long long amount_paise) override {
+        balance_in_paise = MoneyUtils::addMoney(balance_in_paise, amount_paise);
+        recordTransaction(TransactionType::DEPOSIT, amount_paise, "Regular deposit");
+        return TxnStatus::OK;
+    }
+    
+    // Restores used overdraft first; any excess goes to the balance.
+    // Returns the portion applied to the overdraft.
+    long long repayOverdraft(long long amount_paise) {
+        if ((overdraft_limit_paise + amount_paise) > overdraft_cap_paise) {
+            long long to_repay = overdraft_cap_paise - overdraft_limit_paise;
+            if (to_repay > 0) {
+                overdraft_limit_paise = overdraft_cap_paise;
+                balance_in_paise = MoneyUtils::addMoney(balance_in_paise, amount_paise - to_repay);
+                recordTransaction(TransactionType::OVERDRAFT_REPAY, to_repay, "Overdraft repayment");
+                if (amount_paise - to_repay > 0) {
+                    recordTransaction(TransactionType::DEPOSIT, amount_paise - to_repay, "Excess amount to balance");
+                }
+                return to_repay;
+            }
+            balance_in_paise = MoneyUtils::addMoney(balance_in_paise, amount_paise);
+            recordTransaction(TransactionType::DEPOSIT, amount_paise, "Deposit to balance (overdraft full)");
+            return 0;
+        }
+        
+        overdraft_limit_paise = MoneyUtils::addMoney(overdraft_limit_paise, amount_paise);
+        recordTransaction(TransactionType::OVERDRAFT_REPAY, amount_paise, "Overdraft limit restoration");
+        return amount_paise;
+    }
+
+    void processWithdrawal() override {
+        try {
+            long long amount_paise = InputValidator::getValidAmountInPaise("\nEnter amount to withdraw: Rs. ");
+            if (tryWithdraw(amount_paise) != TxnStatus::OK) {
+                cout << "\nTransaction declined: amount exceeds available balance and overdraft limit." << endl;
+                cout << "Available Balance: " << MoneyUtils::formatCurrency(balance_in_paise) << endl;
+                cout << "Available Overdraft: " << MoneyUtils::formatCurrency(overdraft_limit_paise) << endl;
+                return;
+            }
+            
+            cout << "\nWithdrawal successful!" << endl;
+            cout << "Available Balance: " << MoneyUtils::formatCurrency(balance_in_paise) << endl;
+            cout << "Available Overdraft: " << MoneyUtils::formatCurrency(overdraft_limit_paise) << endl;
+            
+        } catch (const BankingException& e) {
+            cout << "\nTransaction failed: " << e.what() << endl;
+        }
+    }
+
+    void processDeposit() override {
+        try {
+            long long amount_paise = InputValidator::getValidAmountInPaise("\nEnter amount to deposit: Rs. ");
+            int choice = InputValidator::getValidChoice(
+                "Where to deposit?\n1. Account Balance\n2. Repay Overdraft\nChoice: ", 1, 2);
+            
+            switch (choice) {
+                case 1:
+                    deposit(amount_paise);
+                    break;
+                case 2: {
+                    long long repaid = repayOverdraft(amount_paise);
+                    if (repaid == 0) {
+                        cout << "Overdraft full. Deposited to main balance." << endl;
+                    } else if (repaid < amount_paise) {
+                        cout << "Repaid " << MoneyUtils::formatCurrency(repaid) << " to overdraft, " 
+                             << MoneyUtils::formatCurrency(amount_paise - repaid) << " to balance." << endl;
+                    }
+                    break;
+                }
+            }
+            
+            cout << "\nDeposit successful!" << endl;
+            cout << "Available Balance: " << MoneyUtils::formatCurrency(balance_in_paise) << endl;
+            cout << "Available Overdraft: " << MoneyUtils::formatCurrency(overdraft_limit_paise) << endl;
+            
+        } catch (const BankingException& e) {
+            cout << "\nDeposit failed: " << e.what() << endl;
+        }
+    }
+
+    void displayAccountInfo() const override {
+        Account::displayAccountInfo();
+        cout << "\nOverdraft Limit: " << MoneyUtils::formatCurrency(overdraft_limit_paise) 
+             << " of " << MoneyUtils::formatCurrency(overdraft_cap_paise) << endl;
+    }
+    
+    AccountType getAccountType() const override {
+        return AccountType::CURRENT;
+    }
+    
+    long long getOverdraftLimitInPaise() const { return overdraft_limit_paise; }
+    long long getOverdraftCapInPaise() const { return overdraft_cap_paise; }
+    
+    AggregateContribution currentContribution() const override {
+        AggregateContribution contribution = Account::currentContribution();
+        contribution.overdraft_cap_paise = overdraft_cap_paise;
+        contribution.overdraft_used_paise = max(0LL, overdraft_cap_paise - overdraft_limit_paise);
+        return contribution;
+    }
+    double getOverdraftLimitInRupees() const { return MoneyUtils::paiseToRupees(overdraft_limit_paise); }
+    double getOverdraftCapInRupees() const { return MoneyUtils::paiseToRupees(overdraft_cap_paise); }
+    
+    void setOverdraftDetails(long long limit_paise, long long cap_paise) { 
+        overdraft_limit_paise = limit_paise; 
+        overdraft_cap_paise = cap_paise; 
+        markDirty();
+    }
+};
+
+// =============================================================================
+// ENHANCED LOAN ACCOUNT CLASS WITH PRECISE EMI CALCULATIONS
+// =============================================================================
+
+class LoanAccount : public Account {
+protected:
+    long long principal_amount_paise;
+    float loan_interest_rate;
+    int tenure_months;
+    long long emi_amount_paise;
+    int payments_made;
+
+public:
+    void getAccountInfo() override {
+        Account::getAccountInfo();
+        principal_amount_paise = balance_in_paise;
+        
+        float min_rate = config ? config->getFloat("loan.min_interest_rate", 1.0f) : 1.0f;
+        float max_rate = config ? config->getFloat("loan.max_interest_rate", 20.0f) : 20.0f;
+        int min_tenure = config ? config->getInt("loan.min_tenure_months", 6) : 6;
+        int max_tenure = config ? config->getInt("loan.max_tenure_months", 360) : 360;
+        
+        cout << "Enter annual interest rate (" << min_rate << "-" << max_rate << "%): ";
+        do {
+            cin >> loan_interest_rate;
+            if (loan_interest_rate < min_rate || loan_interest_rate > max_rate) {
+                cout << "Interest rate must be between " << min_rate << "% and " << max_rate << "%. Try again: ";
+            }
+        } while (loan_interest_rate < min_rate || loan_interest_rate > max_rate);
+        
+        cout << "Enter loan tenure in months (" << min_tenure << "-" << max_tenure << "): ";
+        do {
+            cin >> tenure_months;
+            if (tenure_months < min_tenure || tenure_months > max_tenure) {
+                cout << "Tenure must be between " << min_tenure << " and " << max_tenure << " months. Try again: ";
+            }
+        } while (tenure_months < min_tenure || tenure_months > max_tenure);
+        
+        payments_made = 0;
+        calculateEMI();
+        
+        Logger::getInstance().info("Loan account created - Principal: " + MoneyUtils::formatCurrency(principal_amount_paise) +
+                                  ", Rate: " + to_string(loan_interest_rate) + "%, Tenure: " + to_string(tenure_months) + " months");
+    }
+    
+    void calculateEMI() {
+        float monthly_rate = loan_interest_rate / (12 * 100);
+        float factor = pow(1 + monthly_rate, tenure_months);
+        double emi_rupees = (MoneyUtils::paiseToRupees(principal_amount_paise) * monthly_rate * factor) / (factor - 1);
+        emi_amount_paise = MoneyUtils::rupeesToPaise(emi_rupees);
+    }
+
+    // Applies a loan payment, capped at the outstanding balance. The result
+    // carries the amount actually paid.
+    TxnResult tryMakePayment(long long payment_amount_paise) {
+        ScopedLatency latency(LatencyMetric::EMI_PAYMENT);
+        if (balance_in_paise <= 0) {
+            return TxnResult(TxnStatus::LOAN_CLOSED);
+        }
+        
+        if (payment_amount_paise > balance_in_paise) {
+            payment_amount_paise = balance_in_paise;
+        }
+        
+        balance_in_paise = MoneyUtils::subtractMoney(balance_in_paise, payment_amount_paise);
+        payments_made++;
+        recordTransaction(TransactionType::EMI_PAYMENT, payment_amount_paise, 
+                        "EMI payment #" + to_string(payments_made));
+        
+        if (balance_in_paise <= 0) {
+            balance_in_paise = 0;
+            recordTransaction(TransactionType::LOAN_CLOSED, 0, "Loan account closed - fully paid");
+            Logger::getInstance().info("Loan fully paid - Account: " + to_string(acc_no));
+        }
+        
+        return TxnResult(TxnStatus::OK, payment_amount_paise);
+    }
+    
+    long long makePayment(long long payment_amount_paise) {
+        TxnResult result = tryMakePayment(payment_amount_paise);
+        if (!result.ok()) {
+            throwTxnStatus(result.status, "Loan account " + to_string(acc_no) + " is already fully paid");
+        }
+        return result.amount_paise;
+    }
+    
+    TxnStatus tryDeposit(long long amount_paise) override {
+        return tryMakePayment(amount_paise).status;
+    }
+    
+    TxnStatus tryWithdraw(long long amount_paise) override {
+        (void)amount_paise;
+        return TxnStatus::NOT_PERMITTED;
+    }
+
+    void processWithdrawal() override {
+        cout << "Withdrawal not allowed on loan accounts. Use processDeposit() to make EMI payments." << endl;
+    }
+
+    void processDeposit() override {
+        try {
+            cout << "EMI Amount: " << MoneyUtils::formatCurrency(emi_amount_paise) << endl;
+            cout << "Outstanding Balance: " << MoneyUtils::formatCurrency(balance_in_paise) << endl;
+            
+            int choice = InputValidator::getValidChoice(
+                "\n1. Pay EMI (" + to_string((int)MoneyUtils::paiseToRupees(emi_amount_paise)) + 
+                ")\n2. Pay Custom Amount\nChoice: ", 1, 2);
+            
+            long long payment_amount_paise;
+            if (choice == 1) {
+                payment_amount_paise = emi_amount_paise;
+            } else {
+                payment_amount_paise = InputValidator::getValidAmountInPaise("Enter payment amount: Rs. ");
+            }
+            
+            if (payment_amount_paise > balance_in_paise) {
+                cout << "Payment adjusted to outstanding balance: " << MoneyUtils::formatCurrency(balance_in_paise) << endl;
+            }
+            
+            if (!tryMakePayment(payment_amount_paise).ok()) {
+                cout << "\nPayment declined: loan account is already fully paid." << endl;
+                return;
+            }
+            
+            cout << "\nPayment successful!" << endl;
+            cout << "Outstanding Loan Balance: " << MoneyUtils::formatCurrency(balance_in_paise) << endl;
+            cout << "Payments Made: " << payments_made << " of " << tenure_months << endl;
+            
+            if (balance_in_paise <= 0) {
+                cout << "🎉 Congratulations! Loan has been fully paid!" << endl;
+            }
+            
+        } catch (const exception& e) {
+            cout << "\nPayment failed: " << e.what() << endl;
+        }
+    }
+
+    void displayAccountInfo() const override {
+        Account::displayAccountInfo();
+        cout << "\nPrincipal Amount: " << MoneyUtils::formatCurrency(principal_amount_paise);
+        cout << "\nInterest Rate: " << loan_interest_rate << "% per annum";
+        cout << "\nTenure: " << tenure_months << " months";
+        cout << "\nEMI Amount: " << MoneyUtils::formatCurrency(emi_amount_paise);
+        cout << "\nPayments Made: " << payments_made << " of " << tenure_months;
+        cout << "\nOutstanding Balance: " << MoneyUtils::formatCurrency(balance_in_paise) << endl;
+    }
+    
+    AccountType getAccountType() const override {
+        return AccountType::LOAN;
+    }
+    
+    long long getPrincipalAmountInPaise() const { return principal_amount_paise; }
+    double getPrincipalAmountInRupees() const { return MoneyUtils::paiseToRupees(principal_amount_paise); }
+    float getLoanInterestRate() const { return loan_interest_rate; }
+    int getTenureMonths() const { return tenure_months; }
+    long long getEMIAmountInPaise() const { return emi_amount_paise; }
+    double getEMIAmountInRupees() const { return MoneyUtils::paiseToRupees(emi_amount_paise); }
+    int getPaymentsMade() const { return payments_made; }
+    
+    void setLoanDetails(long long principal_paise, float rate, int tenure, int payments) {
+        principal_amount_paise = principal_paise;
+        loan_interest_rate = rate;
+        tenure_months = tenure;
+        payments_made = payments;
+        calculateEMI();
+        markDirty();
+    }
+};
+
+// =============================================================================
+// ENHANCED USER CLASS
+// =============================================================================
+
+class User {
+private:
+    string username;
+    string hashed_password;
+    string salt;
+    vector<int> owned_accounts;
+    UserRole role;
+    time_t created_date;
+    time_t last_login;
+
+public:
+    User() : role(UserRole::USER) {
+        created_date = TimeUtils::getCurrentUTC();
+        last_login = 0;
+    }
+    
+    User(const string& user, const string& pass, UserRole r = UserRole::USER) : username(user), role(r) {
+        auto hash_result = SecurityManager::runAuthTask([&pass]() { return SecurityManager::hashWithSalt(pass); });
+        hashed_password = hash_result.first;
+        salt = hash_result.second;
+        created_date = TimeUtils::getCurrentUTC();
+        last_login = 0;
+        
+        Logger::getInstance().info("User created: " + username + " with role: " + 
+                                  (r == UserRole::ADMIN ? "ADMIN" : "USER"));
+    }
+    
+    // An outdated hash is replaced with one at the current KDF cost; it is
+    // persisted with the next user save.
+    bool authenticate(const string& password) {
+        pair<string, string> upgraded;
+        bool success = SecurityManager::runAuthTask([this, &password, &upgraded]() {
+            if (!SecurityManager::verifyHash(password, hashed_password, salt)) {
+                return false;
+            }
+            if (SecurityManager::needsRehash(hashed_password)) {
+                upgraded = SecurityManager::hashWithSalt(password);
+            }
+            return true;
+        });
+        if (success) {
+            if (!upgraded.first.empty()) {
+                hashed_password = upgraded.first;
+                salt = upgraded.second;
+                Logger::getInstance().info("Password hash for user " + username + " upgraded to the current KDF cost");
+            }
+            last_login = TimeUtils::getCurrentUTC();
+            Logger::getInstance().info("Successful authentication for user: " + username);
+        } else {
+            Logger::getInstance().warning("Failed authentication attempt for user: " + username);
+        }
+        return success;
+    }
+    
+    void addAccount(int acc_no) {
+        if (find(owned_accounts.begin(), owned_accounts.end(), acc_no) == owned_accounts.end()) {
+            owned_accounts.push_back(acc_no);
+            Logger::getInstance().info("Account " + to_string(acc_no) + " assigned to user: " + username);
+        }
+    }
+    
+    bool ownsAccount(int acc_no) const {
+        return find(owned_accounts.begin(), owned_accounts.end(), acc_no) != owned_accounts.end();
+    }
+    
+    bool isAdmin() const {
+        return role == UserRole::ADMIN;
+    }
+    
+    // Getters and setters
+    string getUsername() const { return username; }
+    const vector<int>& getOwnedAccounts() const { return owned_accounts; }
+    UserRole getRole() const { return role; }
+    time_t getLastLogin() const { return last_login; }
+    
+    void setUserDetails(const string& user, const string& hashedPass, const string& user_salt, 
+                       const vector<int>& accounts, UserRole r = UserRole::USER, 
+                       time_t created = 0, time_t login = 0) {
+        username = user;
+        hashed_password = hashedPass;
+        salt = user_salt;
+        owned_accounts = accounts;
+        role = r;
+        created_date = (created == 0) ? TimeUtils::getCurrentUTC() : created;
+        last_login = login;
+    }
+    
+    string getHashedPassword() const { return hashed_password; }
+    string getSalt() const { return salt; }
+    
+    string toDataString() const {
+        stringstream ss;
+        ss << username << "|" << hashed_password << "|" << salt << "|" << static_cast<int>(role) 
+           << "|" << created_date << "|" << last_login;
+        for (int acc_no : owned_accounts) {
+            ss << "|" << acc_no;
+        }
+        return ss.str();
+    }
+};
+
+// =============================================================================
+// ENHANCED AUTHENTICATION MANAGER WITH THREAD SAFETY
+// =============================================================================
+
+enum class PinCheck {
+    OK,
+    NO_PIN,
+    LOCKED,
+    WRONG_PIN
+};
+
+class AuthenticationManager {
+private:
+    unordered_map<int, pair<string, string>> account_pins;
+    unordered_map<int, int> failed_attempts;
+    unordered_map<int, string> active_otps;
+    static ConfigManager* config;
+    mutable mutex auth_mutex;
+    
+    int getMaxAttempts() const {
+        return config ? config->snapshot().max_pin_attempts : 3;
+    }
+    
+    // Checks a PIN without holding auth_mutex during the KDF, which runs on
+    // the auth pool. The attempt is counted before verifying so concurrent
+    // guesses cannot run past the lockout; a match resets the count.
+    PinCheck checkPin(int acc_no, const string& pin) {
+        ScopedLatency latency(LatencyMetric::AUTH_CHECK);
+        int max_attempts = getMaxAttempts();
+        int attempts = 0;
+        pair<string, string> stored;
+        {
+            lock_guard<mutex> lock(auth_mutex);
+            auto pin_it = account_pins.find(acc_no);
+            if (pin_it == account_pins.end()) {
+                return PinCheck::NO_PIN;
+            }
+            int& failed = failed_attempts[acc_no];
+            if (failed >= max_attempts) {
+                Logger::getInstance().warning("Account " + to_string(acc_no) + " is locked due to failed attempts");
+                return PinCheck::LOCKED;
+            }
+            attempts = ++failed;
+            stored = pin_it->second;
+        }
+        
+        pair<string, string> upgraded;
+        bool matched = SecurityManager::runAuthTask([&pin, &stored, &upgraded]() {
+            if (!SecurityManager::verifyHash(pin, stored.first, stored.second)) {
+                return false;
+            }
+            if (SecurityManager::needsRehash(stored.first)) {
+                upgraded = SecurityManager::hashWithSalt(pin);
+            }
+            return true;
+        });
+        
+        lock_guard<mutex> lock(auth_mutex);
+        if (matched) {
+            failed_attempts[acc_no] = 0;
+            auto pin_it = account_pins.find(acc_no);
+            // Skipped if the PIN was re-registered while this check ran
+            if (!upgraded.first.empty() && pin_it != account_pins.end() && pin_it->second == stored) {
+                pin_it->second = upgraded;
+                savePinsLocked();
+                Logger::getInstance().info("PIN hash for account " + to_string(acc_no) + " upgraded to the current KDF cost");
+            }
+            Logger::getInstance().info("Successful PIN authentication for account: " + to_string(acc_no));
+            return PinCheck::OK;
+        }
+        
+        int remaining = max_attempts - attempts;
+        if (remaining > 0) {
+            Logger::getInstance().warning("Failed PIN attempt for account " + to_string(acc_no) + 
+                                        ", " + to_string(remaining) + " attempts remaining");
+            return PinCheck::WRONG_PIN;
+        }
+        Logger::getInstance().error("Account " + to_string(acc_no) + " locked due to failed PIN attempts");
+        MetricCounters::add(MetricCounter::PIN_LOCKOUTS);
+        return PinCheck::LOCKED;
+    }
+    
+    void savePinsLocked() {
+        string data_dir = config ? config->snapshot().data_directory : "data";
+        create_directories(data_dir);
+        
+        ofstream file(data_dir + "/pins_secure.dat");
+        if (file.is_open()) {
+            for (const auto& pair : account_pins) {
+                file << pair.first << "|" << pair.second.first << "|" << pair.second.second << endl;
+            }
+            file.close();
+            Logger::getInstance().debug("PIN data saved securely");
+        }
+    }
+    
+public:
+    static void setConfig(ConfigManager* cfg) { config = cfg; }
+    
+    // Prompts on the console, so auth_mutex is only taken to store the result.
+    bool registerPin(int acc_no) {
+        string pin, confirm_pin;
+        
+        do {
+            cout << "Set " << (config ? config->snapshot().pin_length : 4) << "-digit PIN: ";
+            cin >> pin;
+            
+            if (!SecurityManager::isValidPin(pin)) {
+                cout << "PIN must be exactly " << (config ? config->snapshot().pin_length : 4) << " digits!" << endl;
+                continue;
+            }
+            
+            cout << "Confirm PIN: ";
+            cin >> confirm_pin;
+            
+            if (pin != confirm_pin) {
+                cout << "PINs do not match! Try again." << endl;
+                continue;
+            }
+            
+            break;
+        } while (true);
+        
+        auto hash_result = SecurityManager::runAuthTask([&pin]() { return SecurityManager::hashWithSalt(pin); });
+        {
+            lock_guard<mutex> lock(auth_mutex);
+            account_pins[acc_no] = {hash_result.first, hash_result.second};
+            failed_attempts[acc_no] = 0;
+            savePinsLocked();
+        }
+        
+        Logger::getInstance().info("PIN registered for account: " + to_string(acc_no));
+        cout << "PIN set successfully!" << endl;
+        return true;
+    }
+    
+    bool authenticate(int acc_no) {
+        if (!hasPin(acc_no)) {
+            cout << "No PIN set for this account. Please set PIN first." << endl;
+            return registerPin(acc_no);
+        }
+        {
+            lock_guard<mutex> lock(auth_mutex);
+            if (failed_attempts[acc_no] >= getMaxAttempts()) {
+                cout << "Account locked due to multiple failed attempts!" << endl;
+                Logger::getInstance().warning("Account " + to_string(acc_no) + " is locked due to failed attempts");
+                return false;
+            }
+        }
+        
+        string pin;
+        cout << "Enter " << (config ? config->snapshot().pin_length : 4) << "-digit PIN: ";
+        cin >> pin;
+        
+        PinCheck result = checkPin(acc_no, pin);
+        if (result == PinCheck::WRONG_PIN) {
+            int remaining;
+            {
+                lock_guard<mutex> lock(auth_mutex);
+                remaining = getMaxAttempts() - failed_attempts[acc_no];
+            }
+            cout << "Wrong PIN! " << remaining << " attempts remaining." << endl;
+        } else if (result == PinCheck::LOCKED) {
+            cout << "Account locked due to multiple failed attempts!" << endl;
+        }
+        return result == PinCheck::OK;
+    }
+    
+    // Non-interactive check for callers that already hold the PIN, such as
+    // daemon sessions. Failed attempts count towards the same lockout.
+    PinCheck verifyPin(int acc_no, const string& pin) {
+        return checkPin(acc_no, pin);
+    }
+    
+    bool hasPin(int acc_no) const {
+        lock_guard<mutex> lock(auth_mutex);
+        return account_pins.find(acc_no) != account_pins.end();
+    }
+    
+    bool authenticateWith2FA(int acc_no) {
+        if (!authenticate(acc_no)) {
+            return false;
+        }
+        
+        string otp = SecurityManager::generateOTP();
+        {
+            lock_guard<mutex> lock(auth_mutex);
+            active_otps[acc_no] = otp;
+        }
+        
+        cout << "\n[DEMO] OTP sent to your registered phone: " << otp << endl;
+        cout << "Enter OTP: ";
+        
+        string entered_otp;
+        cin >> entered_otp;
+        
+        {
+            lock_guard<mutex> lock(auth_mutex);
+            if (active_otps[acc_no] == entered_otp) {
+                active_otps.erase(acc_no);
+                cout << "2FA authentication successful!" << endl;
+                Logger::getInstance().info("Successful 2FA authentication for account: " + to_string(acc_no));
+                return true;
+            } else {
+                cout << "Invalid OTP!" << endl;
+                Logger::getInstance().warning("Invalid OTP entered for account: " + to_string(acc_no));
+                return false;
+            }
+        }
+    }
+    
+    void unlockAccount(int acc_no) {
+        lock_guard<mutex> lock(auth_mutex);
+        failed_attempts[acc_no] = 0;
+        cout << "Account " << acc_no << " unlocked." << endl;
+        Logger::getInstance().info("Account " + to_string(acc_no) + " unlocked by admin");
+    }
+    
+    void savePins() {
+        lock_guard<mutex> lock(auth_mutex);
+        savePinsLocked();
+    }
+    
+    void loadPins() {
+        lock_guard<mutex> lock(auth_mutex);
+        string data_dir = config ? config->snapshot().data_directory : "data";
+        
+        ifstream file(data_dir + "/pins_secure.dat");
+        if (!file.is_open()) {
+            Logger::getInstance().debug("No PIN data file found - starting fresh");
+            return;
+        }
+        
+        string line;
+        while (getline(file, line)) {
+            if (line.empty()) continue;
+            
+            stringstream ss(line);
+            string acc_str, hash, salt;
+            
+            if (getline(ss, acc_str, '|') && getline(ss, hash, '|') && getline(ss, salt)) {
+                try {
+                    int acc_no = stoi(acc_str);
+                    account_pins[acc_no] = {hash, salt};
+                    failed_attempts[acc_no] = 0;
+                } catch (const exception& e) {
+                    Logger::getInstance().warning("Skipped corrupted PIN record: " + line);
+                    continue;
+                }
+            }
+        }
+        file.close();
+        Logger::getInstance().info("Loaded PIN data for " + to_string(account_pins.size()) + " accounts");
+    }
+    
+    size_t getPinCount() const {
+        lock_guard<mutex> lock(auth_mutex);
+        return account_pins.size();
+    }
+};
+
+ConfigManager* AuthenticationManager::config = nullptr;
+
+// =============================================================================
+// MEMORY-MAPPED FILE ACCESS
+// =============================================================================
+
+class MappedFile {
+private:
+    char* data_ptr;
+    size_t length;
+    bool writable;
+#ifdef BANKING_POSIX
+    int fd;
+#else
+    vector<char> buffer;
+    string mapped_filename;
+#endif
+    
+public:
+    MappedFile() : data_ptr(nullptr), length(0), writable(false) {
+#ifdef BANKING_POSIX
+        fd = -1;
+#endif
+    }
+    
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    
+    ~MappedFile() {
+        close();
+    }
+    
+    bool open(const string& filename, bool write_access = false) {
+        close();
+        writable = write_access;
+#ifdef BANKING_POSIX
+        fd = ::open(filename.c_str(), write_access ? O_RDWR : O_RDONLY);
+        if (fd < 0) {
+            return false;
+        }
+        
+        struct stat file_stat;
+        if (fstat(fd, &file_stat) != 0 || file_stat.st_size == 0) {
+            close();
+            return false;
+        }
+        length = static_cast<size_t>(file_stat.st_size);
+        
+        void* mapping = mmap(nullptr, length, write_access ? (PROT_READ | PROT_WRITE) : PROT_READ, 
+                             MAP_SHARED, fd, 0);
+        if (mapping == MAP_FAILED) {
+            close();
+            return false;
+        }
+        data_ptr = static_cast<char*>(mapping);
+#else
+        ifstream file(filename, ios::binary);
+        if (!file.is_open()) {
+            return false;
+        }
+        buffer.assign(istreambuf_iterator<char>(file), istreambuf_iterator<char>());
+        if (buffer.empty()) {
+            return false;
+        }
+        mapped_filename = filename;
+        data_ptr = buffer.data();
+        length = buffer.size();
+#endif
+        return true;
+    }
+    
+    // Pushes in-place modifications back to the file.
+    bool sync() {
+        if (!data_ptr || !writable) return false;
+#ifdef BANKING_POSIX
+        return msync(data_ptr, length, MS_SYNC) == 0;
+#else
+        ofstream file(mapped_filename, ios::binary | ios::in | ios::out);
+        if (!file.is_open()) return false;
+        file.write(data_ptr, length);
+        return file.good();
+#endif
+    }
+    
+    void close() {
+#ifdef BANKING_POSIX
+        if (data_ptr) {
+            munmap(data_ptr, length);
+        }
+        if (fd >= 0) {
+            ::close(fd);
+            fd = -1;
+        }
+#else
+        buffer.clear();
+#endif
+        data_ptr = nullptr;
+        length = 0;
+    }
+    
+    bool isOpen() const { return data_ptr != nullptr; }
+    char* data() { return data_ptr; }
+    const char* data() const { return data_ptr; }
+    size_t size() const { return length; }
+};
+
+// =============================================================================
+// CHUNKED PARALLEL LINE PARSER
+// =============================================================================
+//
+// Parses a newline-delimited buffer by splitting it into chunks on line
+// boundaries and parsing them on a thread pool - the caller's (the startup
+// loader pool) or a private one. The calling thread claims chunks as well and
+// only waits for chunks already being parsed, so it cannot deadlock when it
+// is itself a task on that pool. Each chunk keeps its records in file order,
+// and chunks are concatenated in order, so the result is the same as a
+// sequential pass. Failures are reported with their global line number once
+// all chunks have finished.
+
+class ParallelLineParser {
+public:
+    struct ParseFailure {
+        size_t line_number;
+        size_t column;  // 0 when the failing field is unknown
+        string line;
+        string message;
+    };
+    
+    // Buffers smaller than this are parsed on the calling thread.
+    static constexpr size_t MIN_PARALLEL_BYTES = 1 << 20;
+    
+    // parse_line(string_view line, Record& out) returns false to skip a line
+    // quietly and throws to report it as corrupt. Without a pool, large
+    // buffers get a private one of thread_count - 1 workers.
+    template<typename Record, typename ParseLine>
+    static vector<Record> parse(const char* data, size_t size, size_t thread_count, ParseLine parse_line,
+                                vector<ParseFailure>& failures, ThreadPool* pool = nullptr) {
+        struct Chunk {
+            const char* begin;
+            const char* end;
+            size_t line_count;
+            vector<Record> records;
+            vector<ParseFailure> failures;
+        };
+        
+        // Shared with pool tasks, which may start after the last chunk is claimed
+        struct Work {
+            vector<Chunk> chunks;
+            atomic<size_t> next_chunk{0};
+            size_t finished = 0;
+            exception_ptr error;
+            mutex finished_mutex;
+            condition_variable all_finished;
+        };
+        
+        size_t chunk_count = (size < MIN_PARALLEL_BYTES) ? 1 : max<size_t>(1, thread_count);
+        auto work = make_shared<Work>();
+        vector<Chunk>& chunks = work->chunks;
+        const char* data_end = data + size;
+        const char* chunk_begin = data;
+        for (size_t i = 1; i <= chunk_count && chunk_begin < data_end; i++) {
+            const char* chunk_end = (i == chunk_count) ? data_end : data + size / chunk_count * i;
+            if (chunk_end < chunk_begin) chunk_end = chunk_begin;
+            const char* newline = static_cast<const char*>(memchr(chunk_end, '\n', data_end - chunk_end));
+            chunk_end = newline ? newline + 1 : data_end;
+            chunks.push_back({chunk_begin, chunk_end, 0, {}, {}});
+            chunk_begin = chunk_end;
+        }
+        
+        auto parseChunk = [&parse_line](Chunk& chunk) {
+            const char* cursor = chunk.begin;
+            while (cursor < chunk.end) {
+                const char* newline = static_cast<const char*>(memchr(cursor, '\n', chunk.end - cursor));
+                const char* line_end = newline ? newline : chunk.end;
+                string_view line(cursor, line_end - cursor);
+                cursor = newline ? newline + 1 : chunk.end;
+                chunk.line_count++;
+                if (line.empty()) continue;
+                
+                try {
+                    Record record;
+                    if (parse_line(line, record)) {
+                        chunk.records.push_back(move(record));
+                    }
+                } catch (const RecordParseException& e) {
+                    chunk.failures.push_back({chunk.line_count, e.getColumn(), string(line), e.what()});
+                } catch (const exception& e) {
+                    chunk.failures.push_back({chunk.line_count, 0, string(line), e.what()});
+                }
+            }
+        };
+        
+        if (chunks.size() == 1) {
+            parseChunk(chunks[0]);
+        } else {
+            // Claims chunks until none are left. parse_line is only used
+            // while the caller is still waiting for a claimed chunk.
+            auto runChunks = [work, parseChunk]() {
+                size_t index;
+                while ((index = work->next_chunk.fetch_add(1)) < work->chunks.size()) {
+                    exception_ptr error;
+                    try {
+                        parseChunk(work->chunks[index]);
+                    } catch (...) {
+                        error = current_exception();
+                    }
+                    lock_guard<mutex> lock(work->finished_mutex);
+                    if (error && !work->error) work->error = error;
+                    if (++work->finished == work->chunks.size()) {
+                        work->all_finished.notify_all();
+                    }
+                }
+            };
+            
+            unique_ptr<ThreadPool> private_pool;
+            if (!pool) {
+                private_pool = make_unique<ThreadPool>(chunks.size() - 1);
+                pool = private_pool.get();
+            }
+            for (size_t i = 1; i < chunks.size(); i++) {
+                pool->submit(runChunks);
+            }
+            runChunks();
+            
+            unique_lock<mutex> lock(work->finished_mutex);
+            work->all_finished.wait(lock, [&work]() { return work->finished == work->chunks.size(); });
+            if (work->error) {
+                rethrow_exception(work->error);
+            }
+        }
+        
+        vector<Record> records;
+        size_t total_records = 0;
+        for (const auto& chunk : chunks) total_records += chunk.records.size();
+        records.reserve(total_records);
+        
+        size_t lines_before = 0;
+        for (auto& chunk : chunks) {
+            move(chunk.records.begin(), chunk.records.end(), back_inserter(records));
+            for (auto& failure : chunk.failures) {
+                failure.line_number += lines_before;
+                failures.push_back(move(failure));
+            }
+            lines_before += chunk.line_count;
+        }
+        return records;
+    }
+    
+    static string describe(const ParseFailure& failure) {
+        string location = "line " + to_string(failure.line_number);
+        if (failure.column > 0) {
+            location += ", column " + to_string(failure.column);
+        }
+        return location;
+    }
+};
+
+// =============================================================================
+// VERSIONED BINARY ACCOUNT STORE (accounts.bin)
+// =============================================================================
+//
+// Layout (native little-endian, every section 8-byte aligned):
+//
+//   [BinaryAccountHeader]            fixed 64 bytes
+//   [BinaryAccountRecord x count]    fixed 72 bytes each
+//   [uint32_t slot x slot_count]     open-addressing table: record index + 1
+//   [string heap]                    name / phone / address bytes
+//
+// The file is mapped as-is, so loading does no parsing and a single record
+// can be located through the slot table and patched in place.
+
+struct BinaryAccountHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t endian_tag;
+    uint32_t header_size;
+    uint32_t record_size;
+    uint32_t record_count;
+    uint32_t slot_count;
+    uint64_t records_offset;
+    uint64_t slots_offset;
+    uint64_t heap_offset;
+    uint64_t heap_size;
+};
+
+struct BinarySavingsFields {
+    float interest_rate;
+};
+
+struct BinaryCurrentFields {
+    int64_t overdraft_limit_paise;
+    int64_t overdraft_cap_paise;
+};
+
+struct BinaryLoanFields {
+    int64_t principal_paise;
+    float interest_rate;
+    int32_t tenure_months;
+    int32_t payments_made;
+};
+
+struct BinaryAccountRecord {
+    int32_t account_no;
+    uint32_t account_type;
+    int64_t balance_paise;
+    int64_t created_utc;
+    uint32_t name_offset;
+    uint32_t name_length;
+    uint32_t phone_offset;
+    uint32_t phone_length;
+    uint32_t address_offset;
+    uint32_t address_length;
+    union {
+        BinarySavingsFields savings;
+        BinaryCurrentFields current;
+        BinaryLoanFields loan;
+    } details;
+};
+
+static_assert(sizeof(BinaryAccountHeader) == 64, "BinaryAccountHeader layout changed");
+static_assert(sizeof(BinaryAccountRecord) == 72, "BinaryAccountRecord layout changed");
+
+class BinaryAccountStore {
+private:
+    MappedFile file;
+    BinaryAccountHeader* header;
+    BinaryAccountRecord* records;
+    const uint32_t* slots;
+    const char* heap;
+    bool writable;
+    
+    static constexpr char MAGIC[8] = {'B', 'N', 'K', 'A', 'C', 'C', 'T', '\0'};
+    static constexpr uint32_t FORMAT_VERSION = 1;
+    static constexpr uint32_t ENDIAN_TAG = 0x01020304;
+    
+    static uint64_t alignTo8(uint64_t offset) {
+        return (offset + 7) & ~static_cast<uint64_t>(7);
+    }
+    
+    // Offsets and sizes come from the file, so never add them: a forged
+    // offset near 2^64 would wrap past the check.
+    static bool sectionFits(uint64_t offset, uint64_t length, uint64_t file_size) {
+        return offset <= file_size && length <= file_size - offset;
+    }
+    
+    static uint32_t slotFor(int account_no, uint32_t slot_count) {
+        return (static_cast<uint32_t>(account_no) * 2654435761u) & (slot_count - 1);
+    }
+    
+    static uint32_t slotCountFor(size_t record_count) {
+        uint32_t count = 16;
+        while (count < record_count * 2) {
+            count <<= 1;
+        }
+        return count;
+    }
+    
+    string heapString(uint32_t offset, uint32_t length) const {
+        return string(heap + offset, length);
+    }
+    
+    static void fillTypeFields(BinaryAccountRecord& record, const Account& account) {
+        switch (account.getAccountType()) {
+            case AccountType::SAVINGS: {
+                const SavingsAccount* savings_acc = dynamic_cast<const SavingsAccount*>(&account);
+                if (savings_acc) {
+                    record.details.savings.interest_rate = savings_acc->getInterestRate();
+                }
+                break;
+            }
+            case AccountType::CURRENT: {
+                const CurrentAccount* current_acc = dynamic_cast<const CurrentAccount*>(&account);
+                if (current_acc) {
+                    record.details.current.overdraft_limit_paise = current_acc->getOverdraftLimitInPaise();
+                    record.details.current.overdraft_cap_paise = current_acc->getOverdraftCapInPaise();
+                }
+                break;
+            }
+            case AccountType::LOAN: {
+                const LoanAccount* loan_acc = dynamic_cast<const LoanAccount*>(&account);
+                if (loan_acc) {
+                    record.details.loan.principal_paise = loan_acc->getPrincipalAmountInPaise();
+                    record.details.loan.interest_rate = loan_acc->getLoanInterestRate();
+                    record.details.loan.tenure_months = loan_acc->getTenureMonths();
+                    record.details.loan.payments_made = loan_acc->getPaymentsMade();
+                }
+                break;
+            }
+            default:
+                break;
+        }
+    }
+    
+public:
+    BinaryAccountStore() : header(nullptr), records(nullptr), slots(nullptr), heap(nullptr), writable(false) {}
+    
+    static void serialize(ostream& out, const vector<const Account*>& accounts) {
+        vector<BinaryAccountRecord> record_table;
+        record_table.reserve(accounts.size());
+        string string_heap;
+        
+        auto appendString = [&string_heap](const string& value, uint32_t& offset, uint32_t& length) {
+            offset = static_cast<uint32_t>(string_heap.size());
+            length = static_cast<uint32_t>(value.size());
+            string_heap += value;
+        };
+        
+        for (const Account* account_ptr : accounts) {
+            const Account& account = *account_ptr;
+            BinaryAccountRecord record;
+            memset(&record, 0, sizeof(record));
+            
+            record.account_no = account.getAccountNumber();
+            record.account_type = static_cast<uint32_t>(account.getAccountType());
+            record.balance_paise = account.getBalanceInPaise();
+            record.created_utc = static_cast<int64_t>(account.getCreatedDate());
+            appendString(account.getName(), record.name_offset, record.name_length);
+            appendString(account.getPhoneNumber(), record.phone_offset, record.phone_length);
+            appendString(account.getAddress(), record.address_offset, record.address_length);
+            fillTypeFields(record, account);
+            
+            record_table.push_back(record);
+        }
+        
+        uint32_t slot_count = slotCountFor(record_table.size());
+        vector<uint32_t> slot_table(slot_count, 0);
+        for (uint32_t i = 0; i < record_table.size(); i++) {
+            uint32_t slot = slotFor(record_table[i].account_no, slot_count);
+            while (slot_table[slot] != 0) {
+                slot = (slot + 1) & (slot_count - 1);
+            }
+            slot_table[slot] = i + 1;
+        }
+        
+        BinaryAccountHeader file_header;
+        memset(&file_header, 0, sizeof(file_header));
+        memcpy(file_header.magic, MAGIC, sizeof(MAGIC));
+        file_header.version = FORMAT_VERSION;
+        file_header.endian_tag = ENDIAN_TAG;
+        file_header.header_size = sizeof(BinaryAccountHeader);
+        file_header.record_size = sizeof(BinaryAccountRecord);
+        file_header.record_count = static_cast<uint32_t>(record_table.size());
+        file_header.slot_count = slot_count;
+        file_header.records_offset = alignTo8(sizeof(BinaryAccountHeader));
+        file_header.slots_offset = alignTo8(file_header.records_offset + 
+                                            record_table.size() * sizeof(BinaryAccountRecord));
+        file_header.heap_offset = alignTo8(file_header.slots_offset + slot_count * sizeof(uint32_t));
+        file_header.heap_size = string_heap.size();
+        
+        auto padTo = [&out](uint64_t offset) {
+            static const char zeros[8] = {0};
+            uint64_t position = static_cast<uint64_t>(out.tellp());
+            if (offset > position) {
+                out.write(zeros, offset - position);
+            }
+        };
+        
+        out.write(reinterpret_cast<const char*>(&file_header), sizeof(file_header));
+        padTo(file_header.records_offset);
+        out.write(reinterpret_cast<const char*>(record_table.data()), 
+                  record_table.size() * sizeof(BinaryAccountRecord));
+        padTo(file_header.slots_offset);
+        out.write(reinterpret_cast<const char*>(slot_table.data()), slot_table.size() * sizeof(uint32_t));
+        padTo(file_header.heap_offset);
+        out.write(string_heap.data(), string_heap.size());
+    }
+    
+    bool open(const string& filename, bool write_access = false) {
+        close();
+        if (!file.open(filename, write_access)) {
+            return false;
+        }
+        writable = write_access;
+        
+        if (file.size() < sizeof(BinaryAccountHeader)) {
+            Logger::getInstance().error("Binary account store truncated: " + filename);
+            close();
+            return false;
+        }
+        
+        header = reinterpret_cast<BinaryAccountHeader*>(file.data());
+        if (memcmp(header->magic, MAGIC, sizeof(MAGIC)) != 0 || header->endian_tag != ENDIAN_TAG) {
+            Logger::getInstance().error("Not a binary account store (bad magic or byte order): " + filename);
+            close();
+            return false;
+        }
+        if (header->version != FORMAT_VERSION || header->record_size != sizeof(BinaryAccountRecord)) {
+            Logger::getInstance().error("Unsupported binary account store version " + 
+                                       to_string(header->version) + ": " + filename);
+            close();
+            return false;
+        }
+        
+        uint64_t records_size = static_cast<uint64_t>(header->record_count) * sizeof(BinaryAccountRecord);
+        uint64_t slots_size = static_cast<uint64_t>(header->slot_count) * sizeof(uint32_t);
+        if (!sectionFits(header->records_offset, records_size, file.size()) || 
+            !sectionFits(header->slots_offset, slots_size, file.size()) || 
+            !sectionFits(header->heap_offset, header->heap_size, file.size()) ||
+            header->slot_count == 0 || (header->slot_count & (header->slot_count - 1)) != 0) {
+            Logger::getInstance().error("Binary account store section bounds invalid: " + filename);
+            close();
+            return false;
+        }
+        
+        records = reinterpret_cast<BinaryAccountRecord*>(file.data() + header->records_offset);
+        slots = reinterpret_cast<const uint32_t*>(file.data() + header->slots_offset);
+        heap = file.data() + header->heap_offset;
+        return true;
+    }
+    
+    void close() {
+        file.close();
+        header = nullptr;
+        records = nullptr;
+        slots = nullptr;
+        heap = nullptr;
+        writable = false;
+    }
+    
+    bool isOpen() const { return header != nullptr; }
+    size_t size() const { return header ? header->record_count : 0; }
+    uint32_t getVersion() const { return header ? header->version : 0; }
+    
+    const BinaryAccountRecord* find(int account_no) const {
+        if (!header) return nullptr;
+        
+        uint32_t mask = header->slot_count - 1;
+        uint32_t slot = slotFor(account_no, header->slot_count);
+        for (uint32_t probes = 0; probes < header->slot_count; probes++) {
+            uint32_t entry = slots[slot];
+            if (entry == 0 || entry > header->record_count) {
+                return nullptr;
+            }
+            if (records[entry - 1].account_no == account_no) {
+                return &records[entry - 1];
+            }
+            slot = (slot + 1) & mask;
+        }
+        return nullptr;
+    }
+    
+    string getName(const BinaryAccountRecord& record) const {
+        return heapString(record.name_offset, record.name_length);
+    }
+    
+    string getPhoneNumber(const BinaryAccountRecord& record) const {
+        return heapString(record.phone_offset, record.phone_length);
+    }
+    
+    string getAddress(const BinaryAccountRecord& record) const {
+        return heapString(record.address_offset, record.address_length);
+    }
+    
+    unique_ptr<Account> materialize(const BinaryAccountRecord& record) const {
+        if (static_cast<uint64_t>(record.name_offset) + record.name_length > header->heap_size ||
+            static_cast<uint64_t>(record.phone_offset) + record.phone_length > header->heap_size ||
+            static_cast<uint64_t>(record.address_offset) + record.address_length > header->heap_size) {
+            throw DataIntegrityException("Binary record " + to_string(record.account_no) + 
+                                        " references strings outside the heap");
+        }
+        
+        string name = getName(record);
+        string phone = getPhoneNumber(record);
+        string address = getAddress(record);
+        time_t created = static_cast<time_t>(record.created_utc);
+        
+        switch (static_cast<AccountType>(record.account_type)) {
+            case AccountType::SAVINGS: {
+                auto savings_acc = make_unique<SavingsAccount>();
+                savings_acc->setAccountDetails(record.account_no, name, phone, address, record.balance_paise, created);
+                savings_acc->setInterestRate(record.details.savings.interest_rate);
+                return savings_acc;
+            }
+            case AccountType::CURRENT: {
+                auto current_acc = make_unique<CurrentAccount>();
+                current_acc->setAccountDetails(record.account_no, name, phone, address, record.balance_paise, created);
+                current_acc->setOverdraftDetails(record.details.current.overdraft_limit_paise, 
+                                                 record.details.current.overdraft_cap_paise);
+                return current_acc;
+            }
+            case AccountType::LOAN: {
+                auto loan_acc = make_unique<LoanAccount>();
+                loan_acc->setAccountDetails(record.account_no, name, phone, address, record.balance_paise, created);
+                loan_acc->setLoanDetails(record.details.loan.principal_paise, record.details.loan.interest_rate,
+                                         record.details.loan.tenure_months, record.details.loan.payments_made);
+                return loan_acc;
+            }
+            default:
+                return nullptr;
+        }
+    }
+    
+    map<int, unique_ptr<Account>> loadAll() const {
+        map<int, unique_ptr<Account>> accounts;
+        for (uint32_t i = 0; i < size(); i++) {
+            try {
+                unique_ptr<Account> account = materialize(records[i]);
+                if (account) {
+                    accounts[records[i].account_no] = move(account);
+                }
+            } catch (const exception& e) {
+                Logger::getInstance().warning("Skipped corrupted binary account record #" + to_string(i) + 
+                                            " (Error: " + e.what() + ")");
+            }
+        }
+        return accounts;
+    }
+    
+    // Rewrites the mutable fields of an existing record in place. Returns false
+    // when the account is not in the store or its immutable fields differ, in
+    // which case the caller has to rewrite the whole file.
+    bool patchAccount(const Account& account) {
+        if (!writable) return false;
+        
+        BinaryAccountRecord* record = const_cast<BinaryAccountRecord*>(find(account.getAccountNumber()));
+        if (!record || static_cast<uint64_t>(record->name_offset) + record->name_length > header->heap_size ||
+            static_cast<uint64_t>(record->phone_offset) + record->phone_length > header->heap_size ||
+            static_cast<uint64_t>(record->address_offset) + record->address_length > header->heap_size) {
+            return false;
+        }
+        if (record->account_type != static_cast<uint32_t>(account.getAccountType()) ||
+            record->created_utc != static_cast<int64_t>(account.getCreatedDate()) ||
+            getName(*record) != account.getName() || 
+            getAddress(*record) != account.getAddress() ||
+            getPhoneNumber(*record) != account.getPhoneNumber()) {
+            return false;
+        }
+        
+        record->balance_paise = account.getBalanceInPaise();
+        fillTypeFields(*record, account);
+        return true;
+    }
+    
+    bool sync() {
+        return file.sync();
+    }
+};
+
+constexpr char BinaryAccountStore::MAGIC[8];
+
+// =============================================================================
+// DURABILITY POLICY AND FSYNC ACCOUNTING
+// =============================================================================
+//
+// durability.mode decides when committed data is forced to stable storage:
+//   none         - leave it to the OS page cache; a power failure can lose
+//                  recent commits and even a just-renamed file
+//   per_commit   - fsync the write-ahead log after every commit
+//   group_commit - concurrent commits share one fsync; the committer that
+//                  issues it waits up to durability.group_commit_delay_us for
+//                  in-flight commits to join the batch
+// In every mode except none, atomicSave also fsyncs the temporary file before
+// the rename and the parent directory after it.
+
+enum class DurabilityMode {
+    NONE,
+    PER_COMMIT,
+    GROUP_COMMIT
+};
+
+class Durability {
+public:
+    struct Stats {
+        unsigned long long commits;
+        unsigned long long fsyncs;
+        double elapsed_seconds;
+        double average_commit_us;
+        double max_commit_us;
+        
+        double fsyncsPerSecond() const { return elapsed_seconds > 0 ? fsyncs / elapsed_seconds : 0.0; }
+    };
+    
+private:
+    static ConfigManager* config;
+    static atomic<unsigned long long> fsync_count;
+    static atomic<unsigned long long> commit_count;
+    static atomic<unsigned long long> total_commit_ns;
+    static atomic<unsigned long long> max_commit_ns;
+    static atomic<long long> stats_started_ns;
+    
+    static long long steadyNowNanos() {
+        return chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now().time_since_epoch()).count();
+    }
+    
+public:
+    static void setConfig(ConfigManager* cfg) { config = cfg; }
+    
+    static DurabilityMode getMode() {
+        string mode = config ? config->snapshot().durability_mode : "group_commit";
+        if (mode == "none") return DurabilityMode::NONE;
+        if (mode == "per_commit") return DurabilityMode::PER_COMMIT;
+        return DurabilityMode::GROUP_COMMIT;
+    }
+    
+    static string modeToString(DurabilityMode mode) {
+        switch (mode) {
+            case DurabilityMode::NONE: return "none";
+            case DurabilityMode::PER_COMMIT: return "per_commit";
+            default: return "group_commit";
+        }
+    }
+    
+    static int getGroupCommitDelayMicros() {
+        return max(0, config ? config->snapshot().group_commit_delay_us : 200);
+    }
+    
+#ifdef BANKING_POSIX
+    static bool syncDescriptor(int fd) {
+        if (fd < 0) return false;
+        fsync_count.fetch_add(1, memory_order_relaxed);
+        return ::fsync(fd) == 0;
+    }
+#endif
+    
+    // Opens the path read-only just to fsync it; works for files and
+    // directories. Without POSIX there is no portable equivalent and the
+    // data is left to the OS.
+    static bool syncPath(const string& target) {
+#ifdef BANKING_POSIX
+        int fd = ::open(target.empty() ? "." : target.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+        bool synced = syncDescriptor(fd);
+        ::close(fd);
+        return synced;
+#else
+        (void)target;
+        return true;
+#endif
+    }
+    
+    static void recordCommit(chrono::steady_clock::duration latency) {
+        unsigned long long ns = static_cast<unsigned long long>(chrono::duration_cast<chrono::nanoseconds>(latency).count());
+        commit_count.fetch_add(1, memory_order_relaxed);
+        total_commit_ns.fetch_add(ns, memory_order_relaxed);
+        unsigned long long previous_max = max_commit_ns.load(memory_order_relaxed);
+        while (ns > previous_max && !max_commit_ns.compare_exchange_weak(previous_max, ns, memory_order_relaxed)) {}
+    }
+    
+    static void resetStats() {
+        fsync_count = 0;
+        commit_count = 0;
+        total_commit_ns = 0;
+        max_commit_ns = 0;
+        stats_started_ns = steadyNowNanos();
+    }
+    
+    static Stats getStats() {
+        Stats stats;
+        stats.commits = commit_count.load();
+        stats.fsyncs = fsync_count.load();
+        stats.elapsed_seconds = (steadyNowNanos() - stats_started_ns.load()) / 1e9;
+        stats.average_commit_us = stats.commits ? total_commit_ns.load() / 1e3 / stats.commits : 0.0;
+        stats.max_commit_us = max_commit_ns.load() / 1e3;
+        return stats;
+    }
+    
+    static void printReport() {
+        Stats stats = getStats();
+        cout << "\n💾 Durability (" << modeToString(getMode()) << "):" << endl;
+        cout << "  Commits: " << stats.commits << ", fsyncs: " << stats.fsyncs << " (" << fixed << setprecision(1) 
+             << stats.fsyncsPerSecond() << "/sec)" << endl;
+        cout << "  Commit latency: avg " << fixed << setprecision(1) << stats.average_commit_us << " us, max " 
+             << stats.max_commit_us << " us" << endl;
+    }
+};
+
+ConfigManager* Durability::config = nullptr;
+atomic<unsigned long long> Durability::fsync_count{0};
+atomic<unsigned long long> Durability::commit_count{0};
+atomic<unsigned long long> Durability::total_commit_ns{0};
+atomic<unsigned long long> Durability::max_commit_ns{0};
+atomic<long long> Durability::stats_started_ns{chrono::duration_cast<chrono::nanoseconds>(
+    chrono::steady_clock::now().time_since_epoch()).count()};
+
+// =============================================================================
+// ENHANCED FILE MANAGER WITH ATOMIC OPERATIONS (PRODUCTION FIX #3)
+// =============================================================================
+
+class FileManager {
+private:
+    static ConfigManager* config;
+    
+    static bool writeAtomically(const string& filename, const std::function<void(ofstream&)>& write_function) {
+        string temp_filename = filename + ".tmp";
+        string backup_filename = filename + ".backup";
+        
+        try {
+            create_directories(path(filename).parent_path());
+            
+            ofstream temp_file(temp_filename, ios::binary);
+            if (!temp_file.is_open()) {
+                throw DataIntegrityException("Cannot create temporary file: " + temp_filename);
+            }
+            
+            write_function(temp_file);
+            temp_file.close();
+            
+            if (!temp_file.good()) {
+                throw DataIntegrityException("Failed to write to temporary file: " + temp_filename);
+            }
+            
+            bool durable = Durability::getMode() != DurabilityMode::NONE;
+            if (durable && !Durability::syncPath(temp_filename)) {
+                throw DataIntegrityException("Failed to sync temporary file: " + temp_filename);
+            }
+            
+            if (exists(filename)) {
+                if (exists(backup_filename)) {
+                    remove(backup_filename);
+                }
+                rename(filename, backup_filename);
+            }
+            
+            rename(temp_filename, filename);
+            // The rename itself only survives a power failure once the directory is synced
+            if (durable && !Durability::syncPath(path(filename).parent_path().string())) {
+                Logger::getInstance().warning("Failed to sync directory after saving " + filename);
+            }
+            Logger::getInstance().debug("Atomic save completed for: " + filename);
+            return true;
+            
+        } catch (const exception& e) {
+            if (exists(temp_filename)) {
+                remove(temp_filename);
+            }
+            Logger::getInstance().error("Atomic save failed for " + filename + ": " + e.what());
+            return false;
+        }
+    }
+    
+public:
+    static void setConfig(ConfigManager* cfg) { config = cfg; }
+    
+    static bool atomicSave(const string& filename, const std::function<void(ofstream&)>& write_function) {
+        ScopedLatency latency(LatencyMetric::ATOMIC_SAVE);
+        auto start_time = chrono::steady_clock::now();
+        bool saved = writeAtomically(filename, write_function);
+        MetricCounters::add(MetricCounter::ATOMIC_SAVES);
+        MetricCounters::add(MetricCounter::ATOMIC_SAVE_NANOSECONDS, static_cast<uint64_t>(
+            chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start_time).count()));
+        return saved;
+    }
+    
+    static string accountToRecord(const Account& account) {
+        stringstream record;
+        record << account.getAccountNumber() << "|"
+               << account.getName() << "|"
+               << account.getPhoneNumber() << "|"
+               << account.getAddress() << "|"
+               << account.getBalanceInPaise() << "|"
+               << accountTypeToString(account.getAccountType()) << "|"
+               << account.getCreatedDate();
+        
+        if (account.getAccountType() == AccountType::SAVINGS) {
+            const SavingsAccount* savings_acc = dynamic_cast<const SavingsAccount*>(&account);
+            if (savings_acc) {
+                record << "|" << savings_acc->getInterestRate();
+            }
+        } else if (account.getAccountType() == AccountType::CURRENT) {
+            const CurrentAccount* current_acc = dynamic_cast<const CurrentAccount*>(&account);
+            if (current_acc) {
+                record << "|" << current_acc->getOverdraftLimitInPaise() << "|" << current_acc->getOverdraftCapInPaise();
+            }
+        } else if (account.getAccountType() == AccountType::LOAN) {
+            const LoanAccount* loan_acc = dynamic_cast<const LoanAccount*>(&account);
+            if (loan_acc) {
+                record << "|" << loan_acc->getPrincipalAmountInPaise() << "|" << loan_acc->getLoanInterestRate()
+                       << "|" << loan_acc->getTenureMonths() << "|" << loan_acc->getPaymentsMade();
+            }
+        }
+        
+        return record.str();
+    }
+    
+    // Parses one pipe-delimited account record. Returns nullptr when the record
+    // is structurally incomplete; throws on malformed numeric fields.
+    static unique_ptr<Account> accountFromRecord(string_view line) {
+        RecordFields data(line);
+        
+        if (data.size() < 7) {
+            return nullptr;
+        }
+        
+        int acc_no = data.getInt(0);
+        string name = data.getString(1);
+        string phone = data.getString(2);
+        string address = data.getString(3);
+        long long balance_paise = data.getLongLong(4);
+        AccountType type = stringToAccountType(data[5]);
+        time_t created = static_cast<time_t>(data.getLongLong(6));
+        
+        unique_ptr<Account> account;
+        
+        if (type == AccountType::SAVINGS && data.size() >= 8) {
+            auto savings_acc = make_unique<SavingsAccount>();
+            savings_acc->setAccountDetails(acc_no, name, phone, address, balance_paise, created);
+            savings_acc->setInterestRate(data.getFloat(7));
+            account = move(savings_acc);
+        } else if (type == AccountType::CURRENT && data.size() >= 9) {
+            auto current_acc = make_unique<CurrentAccount>();
+            current_acc->setAccountDetails(acc_no, name, phone, address, balance_paise, created);
+            long long overdraft_limit_paise = data.getLongLong(7);
+            current_acc->setOverdraftDetails(overdraft_limit_paise, data.getLongLong(8));
+            account = move(current_acc);
+        } else if (type == AccountType::LOAN && data.size() >= 11) {
+            auto loan_acc = make_unique<LoanAccount>();
+            loan_acc->setAccountDetails(acc_no, name, phone, address, balance_paise, created);
+            long long principal_paise = data.getLongLong(7);
+            float loan_rate = data.getFloat(8);
+            int tenure_months = data.getInt(9);
+            loan_acc->setLoanDetails(principal_paise, loan_rate, tenure_months, data.getInt(10));
+            account = move(loan_acc);
+        }
+        
+        return account;
+    }
+    
+    static bool useBinaryAccountFormat() {
+        return config && config->snapshot().binary_accounts_format;
+    }
+    
+    static string getAccountsFilename() {
+        string data_dir = config ? config->snapshot().data_directory : "data";
+        return data_dir + (useBinaryAccountFormat() ? "/accounts.bin" : "/accounts.dat");
+    }
+    
+    static vector<const Account*> toAccountList(const map<int, unique_ptr<Account>>& accounts) {
+        vector<const Account*> list;
+        list.reserve(accounts.size());
+        for (const auto& pair : accounts) {
+            list.push_back(pair.second.get());
+        }
+        return list;
+    }
+    
+    static bool saveAccountsToText(const string& filename, const vector<const Account*>& accounts) {
+        return atomicSave(filename, [&accounts](ofstream& file) {
+            for (const Account* account : accounts) {
+                file << accountToRecord(*account) << endl;
+            }
+        });
+    }
+    
+    static bool saveAccountsToBinary(const string& filename, const vector<const Account*>& accounts) {
+        return atomicSave(filename, [&accounts](ofstream& file) {
+            BinaryAccountStore::serialize(file, accounts);
+        });
+    }
+    
+    static bool saveAllAccounts(const vector<const Account*>& accounts) {
+        string filename = getAccountsFilename();
+        create_directories(path(filename).parent_path());
+        
+        bool saved = useBinaryAccountFormat() ? saveAccountsToBinary(filename, accounts) 
+                                              : saveAccountsToText(filename, accounts);
+        
+        if (saved) {
+            Logger::getInstance().info("Saved " + to_string(accounts.size()) + " accounts to file");
+        }
+        return saved;
+    }
+    
+    // Writes the dirty records of the binary store in place and syncs them.
+    // Returns false if any record cannot be patched (new account, changed
+    // strings), leaving the caller to rewrite the whole file.
+    static bool patchAccountsInBinary(const string& filename, const vector<Account*>& dirty_accounts) {
+        BinaryAccountStore store;
+        if (!store.open(filename, true)) {
+            return false;
+        }
+        for (const Account* account : dirty_accounts) {
+            if (!store.patchAccount(*account)) {
+                Logger::getInstance().debug("Account " + to_string(account->getAccountNumber()) + 
+                                           " cannot be patched in place - full rewrite required");
+                return false;
+            }
+        }
+        if (!store.sync()) {
+            Logger::getInstance().error("Failed to sync patched binary account store: " + filename);
+            return false;
+        }
+        return true;
+    }
+    
+    // Persists only what changed since the last save. A clean store is left
+    // untouched; the binary store is patched in place when every dirty record
+    // fits its existing slot and in_place_safe says a torn patch can be
+    // repaired from the write-ahead log. Anything else is a full atomicSave.
+    // Saved accounts are marked clean, so callers must exclude mutators.
+    static bool saveChangedAccounts(const vector<Account*>& accounts, bool in_place_safe) {
+        string filename = getAccountsFilename();
+        vector<Account*> dirty_accounts;
+        for (Account* account : accounts) {
+            if (account->isDirty()) {
+                dirty_accounts.push_back(account);
+            }
+        }
+        
+        bool file_present = exists(filename);
+        if (dirty_accounts.empty() && file_present) {
+            Logger::getInstance().debug("No dirty accounts - skipped rewriting " + filename);
+            return true;
+        }
+        
+        bool saved = false;
+        if (in_place_safe && file_present && useBinaryAccountFormat() && 
+            patchAccountsInBinary(filename, dirty_accounts)) {
+            Logger::getInstance().info("Patched " + to_string(dirty_accounts.size()) + " of " + 
+                                      to_string(accounts.size()) + " accounts in place");
+            saved = true;
+        } else {
+            saved = saveAllAccounts(vector<const Account*>(accounts.begin(), accounts.end()));
+        }
+        
+        if (saved) {
+            for (Account* account : dirty_accounts) {
+                account->clearDirty();
+            }
+        }
+        return saved;
+    }
+    
+    static size_t getParseThreads() {
+        int configured = config ? config->getInt("file.parse_threads", 0) : 0;
+        if (configured > 0) return static_cast<size_t>(configured);
+        return max(1u, thread::hardware_concurrency());
+    }
+    
+    static map<int, unique_ptr<Account>> loadAccountsFromText(const string& filename, ThreadPool* pool = nullptr) {
+        map<int, unique_ptr<Account>> accounts;
+        
+        if (!exists(filename)) {
+            Logger::getInstance().debug("No accounts file found - starting fresh");
+            return accounts;
+        }
+        
+        MappedFile file;
+        vector<unique_ptr<Account>> parsed;
+        vector<ParallelLineParser::ParseFailure> failures;
+        if (file.open(filename)) {
+            parsed = ParallelLineParser::parse<unique_ptr<Account>>(file.data(), file.size(), getParseThreads(),
+                [](string_view line, unique_ptr<Account>& account) {
+                    account = accountFromRecord(line);
+                    return account != nullptr;
+                }, failures, pool);
+        }
+        
+        for (const auto& failure : failures) {
+            Logger::getInstance().warning("Skipped corrupted account record at " + ParallelLineParser::describe(failure) + 
+                                        ": " + failure.line + " (Error: " + failure.message + ")");
+        }
+        
+        int loaded_count = 0;
+        for (auto& account : parsed) {
+            int acc_no = account->getAccountNumber();
+            accounts[acc_no] = move(account);
+            loaded_count++;
+        }
+        
+        Logger::getInstance().info("Loaded " + to_string(loaded_count) + " accounts from file");
+        return accounts;
+    }
+    
+    static map<int, unique_ptr<Account>> loadAccountsFromBinary(const string& filename) {
+        BinaryAccountStore store;
+        if (!store.open(filename)) {
+            Logger::getInstance().debug("No binary accounts file found - starting fresh");
+            return map<int, unique_ptr<Account>>();
+        }
+        
+        map<int, unique_ptr<Account>> accounts = store.loadAll();
+        Logger::getInstance().info("Loaded " + to_string(accounts.size()) + " accounts from binary store (format v" + 
+                                  to_string(store.getVersion()) + ")");
+        return accounts;
+    }
+    
+    // Freshly loaded accounts match the file, so they start clean. Text
+    // files are parsed on the given pool when there is one.
+    static map<int, unique_ptr<Account>> loadAccounts(ThreadPool* pool = nullptr) {
+        string filename = getAccountsFilename();
+        map<int, unique_ptr<Account>> accounts = useBinaryAccountFormat() ? loadAccountsFromBinary(filename) 
+                                                                          : loadAccountsFromText(filename, pool);
+        for (auto& pair : accounts) {
+            pair.second->clearDirty();
+        }
+        return accounts;
+    }
+    
+    static bool convertTextToBinary(const string& text_filename, const string& binary_filename) {
+        if (!exists(text_filename)) {
+            Logger::getInstance().error("Conversion source not found: " + text_filename);
+            return false;
+        }
+        map<int, unique_ptr<Account>> accounts = loadAccountsFromText(text_filename);
+        bool converted = saveAccountsToBinary(binary_filename, toAccountList(accounts));
+        if (converted) {
+            Logger::getInstance().info("Converted " + to_string(accounts.size()) + " accounts from " + 
+                                      text_filename + " to " + binary_filename);
+        }
+        return converted;
+    }
+    
+    static bool convertBinaryToText(const string& binary_filename, const string& text_filename) {
+        if (!exists(binary_filename)) {
+            Logger::getInstance().error("Conversion source not found: " + binary_filename);
+            return false;
+        }
+        map<int, unique_ptr<Account>> accounts = loadAccountsFromBinary(binary_filename);
+        bool converted = saveAccountsToText(text_filename, toAccountList(accounts));
+        if (converted) {
+            Logger::getInstance().info("Converted " + to_string(accounts.size()) + " accounts from " + 
+                                      binary_filename + " to " + text_filename);
+        }
+        return converted;
+    }
+    
+    static void saveAllUsers(const map<string, User>& users) {
+        string data_dir = config ? config->snapshot().data_directory : "data";
+        create_directories(data_dir);
+        
+        string filename = data_dir + "/users_secure.dat";
+        
+        atomicSave(filename, [&users](ofstream& file) {
+            for (const auto& pair : users) {
+                file << pair.second.toDataString() << endl;
+            }
+        });
+        
+        Logger::getInstance().info("Saved " + to_string(users.size()) + " users to file");
+    }
+    
+    static map<string, User> loadUsers(ThreadPool* pool = nullptr) {
+        map<string, User> users;
+        string data_dir = config ? config->snapshot().data_directory : "data";
+        string filename = data_dir + "/users_secure.dat";
+        
+        if (!exists(filename)) {
+            Logger::getInstance().debug("No users file found - starting fresh");
+            return users;
+        }
+        
+        MappedFile file;
+        vector<User> parsed;
+        vector<ParallelLineParser::ParseFailure> failures;
+        if (file.open(filename)) {
+            parsed = ParallelLineParser::parse<User>(file.data(), file.size(), getParseThreads(), userFromRecord, 
+                                                     failures, pool);
+        }
+        
+        for (const auto& failure : failures) {
+            Logger::getInstance().warning("Skipped corrupted user record at " + ParallelLineParser::describe(failure) + 
+                                        ": " + failure.line + " (Error: " + failure.message + ")");
+        }
+        
+        int loaded_count = 0;
+        for (auto& user : parsed) {
+            string username = user.getUsername();
+            users[username] = move(user);
+            loaded_count++;
+        }
+        
+        Logger::getInstance().info("Loaded " + to_string(loaded_count) + " users from file");
+        return users;
+    }
+    
+    // Returns false for structurally incomplete records; throws on malformed numbers.
+    static bool userFromRecord(string_view line, User& user) {
+        RecordFields data(line);
+        if (data.size() < 6) {
+            return false;
+        }
+        
+        UserRole role = static_cast<UserRole>(data.getInt(3));
+        time_t created = static_cast<time_t>(data.getLongLong(4));
+        time_t last_login = static_cast<time_t>(data.getLongLong(5));
+        
+        vector<int> accounts;
+        for (size_t i = 6; i < data.size(); i++) {
+            accounts.push_back(data.getInt(i));
+        }
+        
+        user.setUserDetails(data.getString(0), data.getString(1), data.getString(2), accounts, role, created, last_login);
+        return true;
+    }
+};
+
+ConfigManager* FileManager::config = nullptr;
+
+// =============================================================================
+// APPEND-ONLY WRITE-AHEAD LOG FOR ACCOUNT MUTATIONS
+// =============================================================================
+//
+// Each committed operation appends the records of the accounts it touched,
+// followed by a commit marker:
+//
+//   R|<sequence>|<account record in accounts.dat format>
+//   C|<sequence>|<record count>|<checksum>
+//
+// Only groups terminated by a valid commit marker are replayed. Every
+// wal.checkpoint_interval commits the log is folded back into accounts.dat
+// and truncated.
+
+class WriteAheadLog {
+private:
+    static ConfigManager* config;
+    ofstream wal_file;
+    string wal_filename;
+    unsigned long long next_sequence;
+    int commits_since_checkpoint;
+    mutex wal_mutex;
+    int sync_fd;  // read-only descriptor on the log, used only for fsync
+    
+    // Group commit: the highest sequence written and the highest known to be
+    // on stable storage. One committer at a time syncs on behalf of all.
+    atomic<unsigned long long> written_sequence;
+    unsigned long long durable_sequence;
+    bool sync_in_progress;
+    int writers_in_flight;
+    mutex sync_mutex;
+    condition_variable sync_cv;
+    
+    static unsigned long long checksum(const vector<string>& records) {
+        // FNV-1a: stable across builds, unlike std::hash
+        unsigned long long hash = 1469598103934665603ULL;
+        for (const auto& record : records) {
+            for (unsigned char c : record) {
+                hash ^= c;
+                hash *= 1099511628211ULL;
+            }
+            hash ^= '\n';
+            hash *= 1099511628211ULL;
+        }
+        return hash;
+    }
+    
+    string getWalFilename() const {
+        string data_dir = config ? config->snapshot().data_directory : "data";
+        return data_dir + "/accounts.wal";
+    }
+    
+    void openForAppend() {
+        if (wal_file.is_open()) return;
+        create_directories(path(wal_filename).parent_path());
+        wal_file.open(wal_filename, ios::app | ios::binary);
+        if (!wal_file.is_open()) {
+            Logger::getInstance().error("Cannot open write-ahead log: " + wal_filename);
+            return;
+        }
+#ifdef BANKING_POSIX
+        sync_fd = ::open(wal_filename.c_str(), O_RDONLY);
+#endif
+    }
+    
+    void closeFiles() {
+        if (wal_file.is_open()) {
+            wal_file.close();
+        }
+#ifdef BANKING_POSIX
+        if (sync_fd >= 0) {
+            ::close(sync_fd);
+        }
+#endif
+        sync_fd = -1;
+    }
+    
+    bool syncLog(int fd) {
+#ifdef BANKING_POSIX
+        return Durability::syncDescriptor(fd);
+#else
+        (void)fd;
+        return Durability::syncPath(wal_filename);
+#endif
+    }
+    
+    // Blocks until the commit with the given sequence is on stable storage.
+    // The first waiter to find no sync running becomes the leader: it gives
+    // in-flight writers up to the configured delay to finish, then issues a
+    // single fsync that covers every commit written so far.
+    bool waitUntilDurable(unsigned long long sequence, int fd) {
+        unique_lock<mutex> lock(sync_mutex);
+        while (durable_sequence < sequence) {
+            if (sync_in_progress) {
+                sync_cv.wait(lock);
+                continue;
+            }
+            
+            sync_in_progress = true;
+            int delay_us = Durability::getGroupCommitDelayMicros();
+            if (delay_us > 0) {
+                sync_cv.wait_for(lock, chrono::microseconds(delay_us), [this]() { return writers_in_flight == 0; });
+            }
+            unsigned long long batch_end = written_sequence.load();
+            lock.unlock();
+            
+            bool synced = syncLog(fd);
+            
+            lock.lock();
+            sync_in_progress = false;
+            if (synced) {
+                durable_sequence = max(durable_sequence, batch_end);
+            }
+            sync_cv.notify_all();
+            if (!synced) {
+                Logger::getInstance().error("Write-ahead log fsync failed for commit #" + to_string(sequence));
+                return false;
+            }
+        }
+        return true;
+    }
+    
+    // Writes one commit group; returns its sequence or 0 on failure. In
+    // per_commit mode the log is synced before the lock is released.
+    unsigned long long writeCommit(const vector<const Account*>& changed_accounts, DurabilityMode mode, int& fd) {
+        lock_guard<mutex> lock(wal_mutex);
+        if (wal_filename.empty()) {
+            wal_filename = getWalFilename();
+        }
+        openForAppend();
+        if (!wal_file.is_open()) {
+            return 0;
+        }
+        
+        vector<string> records;
+        records.reserve(changed_accounts.size());
+        for (const Account* account : changed_accounts) {
+            records.push_back(FileManager::accountToRecord(*account));
+        }
+        
+        unsigned long long sequence = next_sequence;
+        string group;
+        for (const auto& record : records) {
+            group += "R|" + to_string(sequence) + "|" + record + "\n";
+        }
+        group += "C|" + to_string(sequence) + "|" + to_string(records.size()) + "|" + 
+                 to_string(checksum(records)) + "\n";
+        
+        wal_file.write(group.data(), group.size());
+        wal_file.flush();
+        
+        if (!wal_file.good()) {
+            Logger::getInstance().error("Write-ahead log append failed for commit #" + to_string(sequence));
+            closeFiles();
+            return 0;
+        }
+        
+        next_sequence++;
+        commits_since_checkpoint++;
+        written_sequence.store(sequence);
+        fd = sync_fd;
+        
+        if (mode == DurabilityMode::PER_COMMIT && !syncLog(sync_fd)) {
+            Logger::getInstance().error("Write-ahead log fsync failed for commit #" + to_string(sequence));
+            return 0;
+        }
+        Logger::getInstance().debug("WAL commit #" + to_string(sequence) + " appended with " + 
+                                   to_string(records.size()) + " records");
+        return sequence;
+    }
+    
+public:
+    static void setConfig(ConfigManager* cfg) { config = cfg; }
+    
+    WriteAheadLog() : next_sequence(1), commits_since_checkpoint(0), sync_fd(-1), written_sequence(0), 
+                      durable_sequence(0), sync_in_progress(false), writers_in_flight(0) {}
+    
+    ~WriteAheadLog() {
+        closeFiles();
+    }
+    
+    static bool isEnabled() {
+        return config ? config->snapshot().wal_enabled : true;
+    }
+    
+    int getCheckpointInterval() const {
+        int interval = config ? config->snapshot().wal_checkpoint_interval : 1000;
+        return max(1, interval);
+    }
+    
+    // Applies every fully committed group in the log on top of the accounts
+    // loaded from accounts.dat. Returns the number of replayed commits.
+    int replay(map<int, unique_ptr<Account>>& accounts) {
+        lock_guard<mutex> lock(wal_mutex);
+        wal_filename = getWalFilename();
+        
+        ifstream file(wal_filename, ios::binary);
+        if (!file.is_open()) {
+            Logger::getInstance().debug("No write-ahead log found - nothing to replay");
+            return 0;
+        }
+        
+        int replayed_commits = 0;
+        int replayed_records = 0;
+        unsigned long long group_sequence = 0;
+        vector<string> group_records;
+        string line;
+        
+        while (getline(file, line)) {
+            if (line.size() < 2 || line[1] != '|') continue;
+            
+            size_t seq_end = line.find('|', 2);
+            if (seq_end == string::npos) continue;
+            
+            try {
+                unsigned long long sequence = stoull(line.substr(2, seq_end - 2));
+                
+                if (line[0] == 'R') {
+                    if (sequence != group_sequence) {
+                        group_records.clear();
+                        group_sequence = sequence;
+                    }
+                    group_records.push_back(line.substr(seq_end + 1));
+                } else if (line[0] == 'C') {
+                    stringstream ss(line.substr(seq_end + 1));
+                    string count_str, checksum_str;
+                    getline(ss, count_str, '|');
+                    getline(ss, checksum_str, '|');
+                    
+                    if (sequence != group_sequence || stoul(count_str) != group_records.size() ||
+                        stoull(checksum_str) != checksum(group_records)) {
+                        Logger::getInstance().warning("Discarded inconsistent WAL commit group #" + to_string(sequence));
+                        group_records.clear();
+                        continue;
+                    }
+                    
+                    for (const auto& record : group_records) {
+                        unique_ptr<Account> account = FileManager::accountFromRecord(record);
+                        if (account) {
+                            int acc_no = account->getAccountNumber();
+                            accounts[acc_no] = move(account);
+                            replayed_records++;
+                        }
+                    }
+                    
+                    group_records.clear();
+                    next_sequence = sequence + 1;
+                    replayed_commits++;
+                }
+            } catch (const exception& e) {
+                Logger::getInstance().warning("Skipped corrupted WAL entry: " + line + " (Error: " + e.what() + ")");
+                group_records.clear();
+            }
+        }
+        file.close();
+        
+        if (!group_records.empty()) {
+            Logger::getInstance().warning("Ignored uncommitted WAL tail with " + to_string(group_records.size()) + " records");
+        }
+        
+        commits_since_checkpoint = replayed_commits;
+        Logger::getInstance().info("Replayed " + to_string(replayed_commits) + " WAL commits (" + 
+                                  to_string(replayed_records) + " account records)");
+        return replayed_commits;
+    }
+    
+    // A commit written to the log; in group-commit mode not yet known durable.
+    struct PendingCommit {
+        unsigned long long sequence = 0;
+        int fd = -1;
+        bool needs_sync = false;
+        chrono::steady_clock::time_point started;
+        
+        bool written() const { return sequence != 0; }
+    };
+    
+    // Appends the current state of the given accounts as one commit group.
+    // Cost is proportional to the number of accounts touched, not the total.
+    // Callers hold the account locks here and release them before
+    // awaitDurable(), so operations on a hot account are not serialised
+    // behind fsync latency.
+    PendingCommit appendCommit(const vector<const Account*>& changed_accounts) {
+        PendingCommit commit;
+        commit.started = chrono::steady_clock::now();
+        DurabilityMode mode = Durability::getMode();
+        
+        if (mode == DurabilityMode::GROUP_COMMIT) {
+            lock_guard<mutex> lock(sync_mutex);
+            writers_in_flight++;
+        }
+        
+        commit.sequence = writeCommit(changed_accounts, mode, commit.fd);
+        commit.needs_sync = (mode == DurabilityMode::GROUP_COMMIT);
+        
+        if (mode == DurabilityMode::GROUP_COMMIT) {
+            lock_guard<mutex> lock(sync_mutex);
+            writers_in_flight--;
+            sync_cv.notify_all();
+        }
+        return commit;
+    }
+    
+    // Returns once the commit is on stable storage. The caller still holds
+    // the persistence gate, so no checkpoint can close the log meanwhile.
+    bool awaitDurable(const PendingCommit& commit) {
+        if (!commit.written()) {
+            return false;
+        }
+        if (commit.needs_sync && !waitUntilDurable(commit.sequence, commit.fd)) {
+            return false;
+        }
+        Durability::recordCommit(chrono::steady_clock::now() - commit.started);
+        return true;
+    }
+    
+    bool isCheckpointDue() {
+        lock_guard<mutex> lock(wal_mutex);
+        return commits_since_checkpoint >= getCheckpointInterval();
+    }
+    
+    // Called once accounts.dat has been rewritten with every committed change.
+    void truncate() {
+        lock_guard<mutex> lock(wal_mutex);
+        if (wal_filename.empty()) {
+            wal_filename = getWalFilename();
+        }
+        closeFiles();
+        if (exists(wal_filename)) {
+            ofstream reset(wal_filename, ios::trunc | ios::binary);
+        }
+        commits_since_checkpoint = 0;
+        Logger::getInstance().debug("Write-ahead log truncated after checkpoint");
+    }
+    
+    int getPendingCommits() {
+        lock_guard<mutex> lock(wal_mutex);
+        return commits_since_checkpoint;
+    }
+};
+
+ConfigManager* WriteAheadLog::config = nullptr;
+
+// =============================================================================
+// CONCURRENT SHARDED ACCOUNT STORE WITH STRIPED PER-ACCOUNT LOCKS
+// =============================================================================
+//
+// The directory is split into shards guarded by reader/writer locks, so
+// lookups from many threads do not contend. Account state is protected by a
+// separate array of striped mutexes; multi-account operations acquire their
+// stripes in ascending index order, which rules out lock-order deadlocks.
+// Accounts are never removed once inserted, so returned pointers stay valid.
+
+class AccountStore {
+public:
+    static constexpr size_t SHARD_COUNT = 16;
+    static constexpr size_t LOCK_STRIPES = 256;
+    
+    struct AccountPairLock {
+        unique_lock<mutex> first;
+        unique_lock<mutex> second;
+        
+        void release() {
+            if (second.owns_lock()) second.unlock();
+            if (first.owns_lock()) first.unlock();
+        }
+    };
+    
+private:
+    struct Shard {
+        mutable shared_mutex shard_mutex;
+        map<int, unique_ptr<Account>> accounts;
+    };
+    
+    array<Shard, SHARD_COUNT> shards;
+    array<mutex, LOCK_STRIPES> stripes;
+    atomic<size_t> account_count;
+    
+    static size_t shardFor(int acc_no) {
+        return static_cast<uint32_t>(acc_no) % SHARD_COUNT;
+    }
+    
+    static size_t stripeFor(int acc_no) {
+        return (static_cast<uint32_t>(acc_no) * 2654435761u) % LOCK_STRIPES;
+    }
+    
+public:
+    AccountStore() : account_count(0) {}
+    
+    AccountStore(const AccountStore&) = delete;
+    AccountStore& operator=(const AccountStore&) = delete;
+    
+    // Bulk load at startup, before any concurrent access.
+    void assign(map<int, unique_ptr<Account>>&& loaded) {
+        for (auto& shard : shards) {
+            unique_lock<shared_mutex> lock(shard.shard_mutex);
+            shard.accounts.clear();
+        }
+        account_count.store(0);
+        for (auto& pair : loaded) {
+            insert(move(pair.second));
+        }
+        loaded.clear();
+    }
+    
+    Account* find(int acc_no) const {
+        const Shard& shard = shards[shardFor(acc_no)];
+        shared_lock<shared_mutex> lock(shard.shard_mutex);
+        auto it = shard.accounts.find(acc_no);
+        return (it != shard.accounts.end()) ? it->second.get() : nullptr;
+    }
+    
+    bool contains(int acc_no) const {
+        return find(acc_no) != nullptr;
+    }
+    
+    // Returns false if the account number is already taken.
+    bool insert(unique_ptr<Account> account) {
+        int acc_no = account->getAccountNumber();
+        Shard& shard = shards[shardFor(acc_no)];
+        unique_lock<shared_mutex> lock(shard.shard_mutex);
+        bool inserted = shard.accounts.emplace(acc_no, move(account)).second;
+        if (inserted) {
+            account_count.fetch_add(1, memory_order_relaxed);
+        }
+        return inserted;
+    }
+    
+    size_t size() const { return account_count.load(memory_order_relaxed); }
+    bool empty() const { return size() == 0; }
+    
+    // All accounts ordered by account number.
+    vector<Account*> getAllAccounts() const {
+        vector<Account*> all;
+        all.reserve(size());
+        for (const auto& shard : shards) {
+            shared_lock<shared_mutex> lock(shard.shard_mutex);
+            for (const auto& pair : shard.accounts) {
+                all.push_back(pair.second.get());
+            }
+        }
+        sort(all.begin(), all.end(), [](const Account* a, const Account* b) {
+            return a->getAccountNumber() < b->getAccountNumber();
+        });
+        return all;
+    }
+    
+    unique_lock<mutex> lockAccount(int acc_no) {
+        return unique_lock<mutex>(stripes[stripeFor(acc_no)]);
+    }
+    
+    // Locks both accounts' stripes in canonical (ascending stripe) order.
+    AccountPairLock lockAccounts(int acc_a, int acc_b) {
+        size_t stripe_a = stripeFor(acc_a);
+        size_t stripe_b = stripeFor(acc_b);
+        AccountPairLock locks;
+        if (stripe_a == stripe_b) {
+            locks.first = unique_lock<mutex>(stripes[stripe_a]);
+        } else {
+            locks.first = unique_lock<mutex>(stripes[min(stripe_a, stripe_b)]);
+            locks.second = unique_lock<mutex>(stripes[max(stripe_a, stripe_b)]);
+        }
+        return locks;
+    }
+};
+
+// =============================================================================
+// PARALLEL MONTH-END INTEREST ENGINE
+// =============================================================================
+//
+// Savings accounts are split into contiguous partitions (a few per worker so
+// uneven partitions balance out) and credited on a thread pool. Each account
+// is updated under its own stripe lock. Each worker collects its partition's
+// INTEREST_APPLIED records and writes them itself, one file handle per
+// account, then indexes them in one call per index, so workers do not queue
+// on the shared appender pool. The caller holds off every other writer.
+
+class InterestEngine {
+public:
+    struct Result {
+        int accounts_credited;
+        long long total_interest_paise;
+        size_t threads_used;
+        double elapsed_seconds;
+        
+        Result() : accounts_credited(0), total_interest_paise(0), threads_used(0), elapsed_seconds(0.0) {}
+    };
+    
+private:
+    static const size_t PARTITIONS_PER_THREAD = 4;
+    
+    // Records reach their files before their index entries are added.
+    static void writePostings(const string& data_dir, const vector<pair<int, Transaction>>& postings) {
+        vector<TransactionIndexEntry> id_entries;
+        vector<TransactionTimeIndex::Observation> time_entries;
+        id_entries.reserve(postings.size());
+        time_entries.reserve(postings.size());
+        
+        for (const auto& posting : postings) {
+            string record = posting.second.toCSV();
+            uint64_t offset = TransactionFileAppender::appendUnpooled(data_dir, posting.first, record + "\n");
+            if (offset == TransactionFileAppender::NO_OFFSET) continue;
+            id_entries.push_back({posting.second.getTransactionId(), offset, posting.first, 
+                                  static_cast<uint32_t>(record.size())});
+            time_entries.push_back({posting.first, posting.second.getTimestamp(), offset});
+        }
+        
+        TransactionIdIndex::getInstance().addAll(id_entries);
+        TransactionTimeIndex::getInstance().observeAll(time_entries);
+    }
+    
+public:
+    static Result run(AccountStore& store, size_t thread_count, const string& data_dir) {
+        Result result;
+        auto start_time = chrono::steady_clock::now();
+        
+        vector<SavingsAccount*> savings_accounts;
+        for (Account* account : store.getAllAccounts()) {
+            if (account->getAccountType() == AccountType::SAVINGS) {
+                savings_accounts.push_back(static_cast<SavingsAccount*>(account));
+            }
+        }
+        
+        if (!savings_accounts.empty()) {
+            TransactionFileAppender::getInstance().closeAll();
+            create_directories(data_dir);
+            
+            ThreadPool pool(min(thread_count, savings_accounts.size()));
+            result.threads_used = pool.getThreadCount();
+            
+            size_t partition_count = min(savings_accounts.size(), result.threads_used * PARTITIONS_PER_THREAD);
+            size_t partition_size = (savings_accounts.size() + partition_count - 1) / partition_count;
+            
+            vector<future<pair<int, long long>>> partials;
+            for (size_t begin = 0; begin < savings_accounts.size(); begin += partition_size) {
+                size_t end = min(begin + partition_size, savings_accounts.size());
+                partials.push_back(pool.submit([&store, &savings_accounts, &data_dir, begin, end]() {
+                    int credited = 0;
+                    long long interest_paise = 0;
+                    AggregateContribution aggregate_delta;
+                    vector<pair<int, Transaction>> postings;
+                    postings.reserve(end - begin);
+                    for (size_t i = begin; i < end; i++) {
+                        SavingsAccount* savings_acc = savings_accounts[i];
+                        unique_lock<mutex> account_lock = store.lockAccount(savings_acc->getAccountNumber());
+                        Transaction posting = savings_acc->postMonthlyInterest();
+                        interest_paise = MoneyUtils::addMoney(interest_paise, posting.getAmountInPaise());
+                        aggregate_delta += savings_acc->takeAggregateDelta();
+                        postings.emplace_back(savings_acc->getAccountNumber(), move(posting));
+                        credited++;
+                    }
+                    SystemAggregates::getInstance().apply(aggregate_delta);
+                    writePostings(data_dir, postings);
+                    return make_pair(credited, interest_paise);
+                }));
+            }
+            
+            for (auto& partial : partials) {
+                pair<int, long long> partition_result = partial.get();
+                result.accounts_credited += partition_result.first;
+                result.total_interest_paise = MoneyUtils::addMoney(result.total_interest_paise, partition_result.second);
+            }
+        }
+        
+        result.elapsed_seconds = chrono::duration<double>(chrono::steady_clock::now() - start_time).count();
+        Logger::getInstance().info("Month-end interest: " + to_string(result.accounts_credited) + " accounts, " + 
+                                  MoneyUtils::formatCurrency(result.total_interest_paise) + " credited in " + 
+                                  to_string(result.elapsed_seconds) + "s on " + to_string(result.threads_used) + " threads");
+        return result;
+    }
+};
+
+// =============================================================================
+// COMPLETE BANKING SYSTEM WITH TRANSACTION ROLLBACK (PRODUCTION FIX #4)
+// =============================================================================
+
+class BankingSystem {
+public:
+    struct StartupPhase {
+        string name;
+        double elapsed_seconds;
+        size_t records;
+    };
+    
+private:
+    AccountStore accounts;
+    map<string, User> users;
+    AuthenticationManager auth_manager;
+    string current_username;
+    ConfigManager* config;
+    WriteAheadLog wal;
+    
+    // Operations hold this shared while mutating and logging accounts;
+    // checkpoints take it exclusively so no commit lands between the
+    // accounts.dat rewrite and the WAL truncation.
+    shared_mutex persistence_gate;
+    atomic<bool> checkpoint_requested;
+    // Set when a commit reached memory but not the WAL; the next checkpoint
+    // then cannot rely on replay to repair a torn in-place patch.
+    atomic<bool> wal_incomplete;
+    
+    vector<StartupPhase> startup_phases;
+    double startup_seconds;
+    
+    template<typename Load>
+    static StartupPhase runStartupPhase(const string& name, Load load) {
+        auto start_time = chrono::steady_clock::now();
+        size_t records = load();
+        return {name, chrono::duration<double>(chrono::steady_clock::now() - start_time).count(), records};
+    }
+    
+    // Loads every account's history tail in parallel; returns records loaded.
+    size_t preloadHistory(ThreadPool& pool) {
+        vector<Account*> all_accounts = accounts.getAllAccounts();
+        if (all_accounts.empty()) return 0;
+        
+        size_t partition_count = min(all_accounts.size(), pool.getThreadCount() * 4);
+        size_t partition_size = (all_accounts.size() + partition_count - 1) / partition_count;
+        vector<future<size_t>> partials;
+        for (size_t begin = 0; begin < all_accounts.size(); begin += partition_size) {
+            size_t end = min(begin + partition_size, all_accounts.size());
+            partials.push_back(pool.submit([&all_accounts, begin, end]() {
+                size_t records = 0;
+                for (size_t i = begin; i < end; i++) {
+                    records += all_accounts[i]->getTransactionHistory().size();
+                }
+                return records;
+            }));
+        }
+        
+        size_t total_records = 0;
+        for (auto& partial : partials) {
+            total_records += partial.get();
+        }
+        return total_records;
+    }
+    
+    User* getCurrentUser() {
+        if (current_username.empty()) return nullptr;
+        auto it = users.find(current_username);
+        return (it != users.end()) ? &it->second : nullptr;
+    }
+    
+public:
+    BankingSystem(ConfigManager* cfg) : config(cfg), checkpoint_requested(false), wal_incomplete(false), 
+                                        startup_seconds(0.0) {
+        auto startup_begin = chrono::steady_clock::now();
+        ThreadPool loader_pool(ThreadPool::resolveThreadCount(config->getInt("startup.threads", 0)));
+        
+        // Independent data files load concurrently
+        map<int, unique_ptr<Account>> loaded_accounts;
+        // Large text files are parsed in chunks on this same pool
+        future<StartupPhase> accounts_phase = loader_pool.submit([&loaded_accounts, &loader_pool]() {
+            return runStartupPhase("accounts", [&loaded_accounts, &loader_pool]() {
+                loaded_accounts = FileManager::loadAccounts(&loader_pool);
+                return loaded_accounts.size();
+            });
+        });
+        future<StartupPhase> users_phase = loader_pool.submit([this, &loader_pool]() {
+            return runStartupPhase("users", [this, &loader_pool]() {
+                users = FileManager::loadUsers(&loader_pool);
+                return users.size();
+            });
+        });
+        future<StartupPhase> pins_phase = loader_pool.submit([this]() {
+            return runStartupPhase("pins", [this]() {
+                auth_manager.loadPins();
+                return auth_manager.getPinCount();
+            });
+        });
+        future<StartupPhase> index_phase = loader_pool.submit([]() {
+            return runStartupPhase("txn_index", []() {
+                TransactionIdIndex::getInstance().load();
+                return TransactionIdIndex::getInstance().size();
+            });
+        });
+        
+        startup_phases.push_back(accounts_phase.get());
+        startup_phases.push_back(users_phase.get());
+        startup_phases.push_back(pins_phase.get());
+        startup_phases.push_back(index_phase.get());
+        
+        int replayed_commits = 0;
+        startup_phases.push_back(runStartupPhase("wal_replay", [this, &loaded_accounts, &replayed_commits]() {
+            replayed_commits = wal.replay(loaded_accounts);
+            return static_cast<size_t>(replayed_commits);
+        }));
+        
+        int max_acc_no = config->getInt("account.starting_account_number", 100000);
+        for (const auto& pair : loaded_accounts) {
+            max_acc_no = max(max_acc_no, pair.first);
+        }
+        AccountManager::setNextAccountNumber(max_acc_no);
+        
+        accounts.assign(move(loaded_accounts));
+        for (Account* account : accounts.getAllAccounts()) {
+            account->publishAggregates();
+        }
+        if (replayed_commits > 0) {
+            checkpoint();
+        }
+        
+        if (config->getInt("startup.preload_history", 0) != 0) {
+            startup_phases.push_back(runStartupPhase("history", [this, &loader_pool]() {
+                return preloadHistory(loader_pool);
+            }));
+        }
+        
+        startup_seconds = chrono::duration<double>(chrono::steady_clock::now() - startup_begin).count();
+        for (const auto& phase : startup_phases) {
+            Logger::getInstance().info("Startup phase " + phase.name + ": " + to_string(phase.records) + 
+                                      " records in " + to_string(phase.elapsed_seconds) + "s");
+        }
+        Logger::getInstance().info("Banking system initialized - Loaded " + to_string(accounts.size()) + 
+                                  " accounts and " + to_string(users.size()) + " users in " + 
+                                  to_string(startup_seconds) + "s");
+        
+        bool hasAdmin = false;
+        for (const auto& pair : users) {
+            if (pair.second.getRole() == UserRole::ADMIN) {
+                hasAdmin = true;
+                break;
+            }
+        }
+        
+        if (!hasAdmin) {
+            User admin("admin", "admin123", UserRole::ADMIN);
+            users["admin"] = admin;
+            Logger::getInstance().info("Default admin user created (username: admin, password: admin123)");
+            cout << "🔐 Default admin user created (username: admin, password: admin123)" << endl;
+        }
+        MetricsExporter::bankOpened();
+    }
+    
+    ~BankingSystem() {
+        saveAllData();
+        TransactionFileAppender::getInstance().shutdown();
+        // Accounts still hold their aggregate contributions here
+        MetricsExporter::bankClosing();
+    }
+    
+    // Folds all committed WAL entries into the accounts file, writing only
+    // dirty records. The log is only truncated once those records are durable
+    // (patched and synced, or atomically rewritten), so a crash mid-patch is
+    // repaired by replay.
+    bool checkpoint() {
+        unique_lock<shared_mutex> gate(persistence_gate);
+        
+        TransactionFileAppender::getInstance().flushAll();
+        TransactionIdIndex::getInstance().flush();
+        TransactionTimeIndex::getInstance().flush();
+        vector<Account*> all_accounts = accounts.getAllAccounts();
+        // A torn in-place patch is only repairable if replay covers every dirty record
+        bool in_place_safe = WriteAheadLog::isEnabled() && !wal_incomplete.load() &&
+            all_of(all_accounts.begin(), all_accounts.end(), [](const Account* account) {
+                return !account->isDirty() || account->isWalLogged();
+            });
+        if (!FileManager::saveChangedAccounts(all_accounts, in_place_safe)) {
+            Logger::getInstance().error("Checkpoint failed - write-ahead log retained for replay");
+            return false;
+        }
+        wal.truncate();
+        wal_incomplete.store(false);
+        checkpoint_requested.store(false);
+        Logger::getInstance().info("Checkpoint completed for " + to_string(all_accounts.size()) + " accounts");
+        return true;
+    }
+    
+    // Appends the accounts touched by one committed operation to the WAL.
+    // Concurrent callers hold persistence_gate shared plus the account locks,
+    // then release the account locks and pass the result to awaitCommit();
+    // any checkpoint this makes due runs later via checkpointIfRequested().
+    WriteAheadLog::PendingCommit logCommit(const vector<int>& acc_nos) {
+        // Index entries must not reach disk before the records they point to;
+        // with time/size flushing they are written at the next checkpoint.
+        if (TransactionFileAppender::getInstance().commit()) {
+            TransactionIdIndex::getInstance().flush();
+            TransactionTimeIndex::getInstance().flush();
+        }
+        
+        vector<Account*> changed;
+        for (int acc_no : acc_nos) {
+            Account* account = findAccount(acc_no);
+            if (account) {
+                account->publishAggregates();
+                changed.push_back(account);
+            }
+        }
+        
+        if (!WriteAheadLog::isEnabled()) {
+            checkpoint_requested.store(true);
+            return WriteAheadLog::PendingCommit();
+        }
+        
+        WriteAheadLog::PendingCommit pending = wal.appendCommit(vector<const Account*>(changed.begin(), changed.end()));
+        if (!pending.written()) {
+            Logger::getInstance().warning("WAL append failed - falling back to full save");
+            wal_incomplete.store(true);
+            checkpoint_requested.store(true);
+            return pending;
+        }
+        for (Account* account : changed) {
+            account->markWalLogged();
+        }
+        
+        if (wal.isCheckpointDue()) {
+            checkpoint_requested.store(true);
+        }
+        return pending;
+    }
+    
+    // Waits until a logged commit is durable, before the caller reports it.
+    // Call with the account locks released but persistence_gate still held.
+    void awaitCommit(const WriteAheadLog::PendingCommit& pending) {
+        if (pending.written() && !wal.awaitDurable(pending)) {
+            Logger::getInstance().warning("WAL sync failed - falling back to full save");
+            wal_incomplete.store(true);
+            checkpoint_requested.store(true);
+        }
+    }
+    
+    void checkpointIfRequested() {
+        if (checkpoint_requested.load()) {
+            checkpoint();
+        }
+    }
+    
+    // Persists the accounts touched by one committed operation.
+    void commitAccounts(const vector<int>& acc_nos) {
+        awaitCommit(logCommit(acc_nos));
+        checkpointIfRequested();
+    }
+    
+    // Restores the balances captured by a rolled-back TransactionManager.
+    void restoreBalances(const vector<TransactionManager::AccountSnapshot>& rollback_data) {
+        for (const auto& snapshot : rollback_data) {
+            Account* acc = findAccount(snapshot.account_no);
+            if (acc && snapshot.modified) {
+                acc->setBalanceInPaise(snapshot.previous_balance_paise);
+                Logger::getInstance().info("Restored account " + to_string(snapshot.account_no) + 
+                                          " to previous balance: " + 
+                                          MoneyUtils::formatCurrency(snapshot.previous_balance_paise));
+            }
+        }
+    }
+    
+    // Runs one single-account operation under the persistence gate and the
+    // account's lock and commits it if it succeeds. A fault thrown part-way
+    // through is rolled back as for transfers before it propagates. Unlike
+    // the menu paths this is safe to call from many threads at once.
+    TxnResult tryAccountOperation(int acc_no, const function<TxnResult(Account&)>& operation) {
+        Account* account = findAccount(acc_no);
+        if (!account) {
+            return TxnResult(TxnStatus::ACCOUNT_NOT_FOUND);
+        }
+        
+        TxnResult result;
+        {
+            shared_lock<shared_mutex> gate(persistence_gate);
+            WriteAheadLog::PendingCommit pending;
+            {
+                unique_lock<mutex> account_lock = accounts.lockAccount(acc_no);
+                TransactionManager transaction_manager;
+                transaction_manager.beginTransaction();
+                transaction_manager.snapshotAccount(acc_no, account->getBalanceInPaise());
+                try {
+                    result = operation(*account);
+                    transaction_manager.updateAccountBalance(acc_no, account->getBalanceInPaise());
+                    transaction_manager.commit();
+                } catch (const exception& e) {
+                    // The operation may have moved the balance before throwing
+                    transaction_manager.updateAccountBalance(acc_no, account->getBalanceInPaise());
+                    restoreBalances(transaction_manager.rollback());
+                    Logger::getInstance().error("Operation on account " + to_string(acc_no) + 
+                                               " failed and rolled back: " + string(e.what()));
+                    throw;
+                }
+                if (result.ok()) {
+                    pending = logCommit({acc_no});
+                }
+            }
+            awaitCommit(pending);
+        }
+        
+        if (result.ok()) {
+            checkpointIfRequested();
+        }
+        return result;
+    }
+    
+    // Reads an account under its lock. Returns false if it does not exist.
+    bool readAccount(int acc_no, const function<void(const Account&)>& reader) {
+        Account* account = findAccount(acc_no);
+        if (!account) {
+            return false;
+        }
+        unique_lock<mutex> account_lock = accounts.lockAccount(acc_no);
+        reader(*account);
+        return true;
+    }
+    
+    AuthenticationManager& getAuthenticationManager() { return auth_manager; }
+    
+    void saveAllData() {
+        checkpoint();
+        FileManager::saveAllUsers(users);
+        auth_manager.savePins();
+        Logger::getInstance().info("All banking system data saved successfully");
+        cout << "💾 All data saved securely." << endl;
+    }
+    
+    bool userLogin() {
+        cout << "\n=== SECURE USER LOGIN ===" << endl;
+        cout << "1. Login to existing account" << endl;
+        cout << "2. Create new user account" << endl;
+        cout << "3. Continue as guest (limited access)" << endl;
+        
+        int choice = InputValidator::getValidChoice("Enter choice: ", 1, 3);
+        
+        if (choice == 3) {
+            current_username.clear();
+            cout << "Continuing in guest mode (limited access)" << endl;
+            Logger::getInstance().info("User continued in guest mode");
+            return true;
+        }
+        
+        if (choice == 2) {
+            return createNewUser();
+        } else {
+            return authenticateUser();
+        }
+    }
+    
+    bool createNewUser() {
+        string username = InputValidator::getValidString("Enter new username: ");
+        
+        if (users.find(username) != users.end()) {
+            cout << "Username already exists!" << endl;
+            return false;
+        }
+        
+        string password = InputValidator::getValidString("Enter password (min " + 
+            to_string(config->snapshot().min_password_length) + " characters): ");
+        
+        if (!SecurityManager::isValidPassword(password)) {
+            cout << "Password too short! Minimum length: " << config->snapshot().min_password_length << endl;
+            return false;
+        }
+        
+        User new_user(username, password);
+        users[username] = new_user;
+        current_username = username;
+        
+        cout << "✅ User account created successfully!" << endl;
+        return true;
+    }
+    
+    bool authenticateUser() {
+        string username = InputValidator::getValidString("Enter username: ");
+        
+        if (users.find(username) == users.end()) {
+            cout << "❌ Username not found!" << endl;
+            return false;
+        }
+        
+        string password = InputValidator::getValidString("Enter password: ");
+        
+        if (users[username].authenticate(password)) {
+            current_username = username;
+            cout << "✅ Login successful! Welcome " << username << endl;
+            
+            time_t last_login = users[username].getLastLogin();
+            if (last_login > 0) {
+                cout << "📅 Last login: " << TimeUtils::formatTimestampUTC(last_login) << endl;
+            }
+            
+            return true;
+        } else {
+            cout << "❌ Invalid password!" << endl;
+            return false;
+        }
+    }
+    
+    void createAccount(AccountType type) {
+        unique_ptr<Account> new_account;
+        
+        switch (type) {
+            case AccountType::SAVINGS:
+                new_account = make_unique<SavingsAccount>();
+                break;
+            case AccountType::CURRENT:
+                new_account = make_unique<CurrentAccount>();
+                break;
+            case AccountType::LOAN:
+                new_account = make_unique<LoanAccount>();
+                break;
+            default:
+                cout << "❌ Invalid account type!" << endl;
+                return;
+        }
+        
+        int acc_no;
+        do {
+            new_account->getAccountInfo();
+            acc_no = new_account->getAccountNumber();
+            
+            if (accounts.contains(acc_no)) {
+                cout << "⚠️ Account number " << acc_no << " already exists!" << endl;
+                cout << "Please choose a different number or use auto-generation." << endl;
+            }
+        } while (accounts.contains(acc_no));
+        
+        auth_manager.registerPin(acc_no);
+        
+        User* current_user = getCurrentUser();
+        if (current_user) {
+            current_user->addAccount(acc_no);
+        }
+        
+        new_account->publishAggregates();
+        accounts.insert(move(new_account));
+        cout << "\n🎉 " << accountTypeToString(type) << " Account Created Successfully!" << endl;
+        
+        saveAllData();
+    }
+    
+    Account* findAccount(int acc_no) {
+        return accounts.find(acc_no);
+    }
+    
+    // Adds a fully initialised account without any console interaction.
+    bool addAccount(unique_ptr<Account> account) {
+        int acc_no = account->getAccountNumber();
+        Account* added = account.get();
+        if (!accounts.insert(move(account))) {
+            return false;
+        }
+        added->publishAggregates();
+        Logger::getInstance().info("Account added: " + to_string(acc_no));
+        return true;
+    }
+    
+    // Looks a transaction up through the ID index; no history file is scanned.
+    bool findTransaction(uint64_t transaction_id, int& account_no, string& record) {
+        return TransactionIdIndex::getInstance().fetch(transaction_id, account_no, record);
+    }
+    
+    long long getTotalBalanceInPaise() {
+        unique_lock<shared_mutex> gate(persistence_gate);
+        long long total_paise = 0;
+        for (const Account* account : accounts.getAllAccounts()) {
+            total_paise = MoneyUtils::addMoney(total_paise, account->getBalanceInPaise());
+        }
+        return total_paise;
+    }
+    
+    size_t getAccountCount() const {
+        return accounts.size();
+    }
+    
+    void printStartupReport() const {
+        cout << "\n=== ⏱️ STARTUP REPORT ===" << endl;
+        cout << left << setw(14) << "Phase" << setw(14) << "Time (s)" << "Records" << endl;
+        cout << string(40, '-') << endl;
+        size_t total_records = 0;
+        for (const auto& phase : startup_phases) {
+            cout << left << setw(14) << phase.name << setw(14) << fixed << setprecision(4) << phase.elapsed_seconds 
+                 << phase.records << endl;
+            total_records += phase.records;
+        }
+        cout << string(40, '-') << endl;
+        cout << "Total records: " << total_records << endl;
+        cout << "Wall time:     " << fixed << setprecision(4) << startup_seconds << " s (file phases run concurrently)" << endl;
+    }
+    
+    bool canAccessAccount(int acc_no) {
+        User* current_user = getCurrentUser();
+        if (!current_user) {
+            return false;
+        }
+        return current_user->ownsAccount(acc_no) || current_user->isAdmin();
+    }
+    
+    void transferMoney() {
+        cout << "\n=== 💸 SECURE MONEY TRANSFER ===" << endl;
+        
+        User* current_user = getCurrentUser();
+        if (!current_user) {
+            cout << "❌ Please login to perform transfers." << endl;
+            return;
+        }
+        
+        int from_acc = InputValidator::getValidAccountNumber("Enter source account number: ");
+        Account* source = findAccount(from_acc);
+        
+        if (!source) {
+            cout << "❌ Source account not found!" << endl;
+            return;
+        }
+        
+        if (!canAccessAccount(from_acc)) {
+            cout << "❌ You don't have access to this account!" << endl;
+            return;
+        }
+        
+        if (!auth_manager.authenticateWith2FA(from_acc)) {
+            return;
+        }
+        
+        int to_acc = InputValidator::getValidAccountNumber("Enter destination account number: ");
+        Account* destination = findAccount(to_acc);
+        
+        if (!destination) {
+            cout << "❌ Destination account not found!" << endl;
+            return;
+        }
+        
+        if (from_acc == to_acc) {
+            cout << "❌ Cannot transfer to the same account!" << endl;
+            return;
+        }
+        
+        long long amount_paise = InputValidator::getValidAmountInPaise("Enter transfer amount: Rs. ");
+        
+        cout << "\n📋 Transfer Details:" << endl;
+        cout << "From: " << source->getName() << " (Account: " << from_acc << ")" << endl;
+        cout << "To: " << destination->getName() << " (Account: " << to_acc << ")" << endl;
+        cout << "Amount: " << MoneyUtils::formatCurrency(amount_paise) << endl;
+        
+        int confirm = InputValidator::getValidChoice("✅ Confirm transfer? (1-Yes, 0-No): ", 0, 1);
+        if (confirm == 0) {
+            cout << "❌ Transfer cancelled." << endl;
+            return;
+        }
+        
+        try {
+            TxnResult result = tryTransfer(from_acc, to_acc, amount_paise);
+            if (!result.ok()) {
+                cout << "\n❌ Transfer declined (" << txnStatusToString(result.status) << "). No money was moved." << endl;
+                return;
+            }
+            
+            cout << "\n✅ Transfer successful!" << endl;
+            cout << "💰 " << MoneyUtils::formatCurrency(amount_paise) << " transferred from Account " << from_acc 
+                 << " to Account " << to_acc << endl;
+            cout << "📊 New balance - Source: " << MoneyUtils::formatCurrency(source->getBalanceInPaise()) << endl;
+            
+        } catch (const exception& e) {
+            cout << "\n❌ Transfer failed and rolled back: " << e.what() << endl;
+        }
+    }
+    
+    // Moves money between two accounts under TransactionManager rollback and
+    // persists both accounts. Declines are returned with nothing changed;
+    // only real faults throw, after the rollback has restored both balances.
+    TxnResult tryTransfer(int from_acc, int to_acc, long long amount_paise) {
+        ScopedLatency latency(LatencyMetric::TRANSFER);
+        Account* source = findAccount(from_acc);
+        Account* destination = findAccount(to_acc);
+        
+        if (!source || !destination) {
+            return TxnResult(TxnStatus::ACCOUNT_NOT_FOUND);
+        }
+        if (from_acc == to_acc) {
+            return TxnResult(TxnStatus::SAME_ACCOUNT);
+        }
+        if (!InputValidator::isValidAmount(amount_paise)) {
+            return TxnResult(TxnStatus::INVALID_AMOUNT);
+        }
+        
+        {
+            shared_lock<shared_mutex> gate(persistence_gate);
+            AccountStore::AccountPairLock account_locks = accounts.lockAccounts(from_acc, to_acc);
+            
+            // Checked under the account locks, so the debit below cannot decline
+            if (!source->canDebit(amount_paise)) {
+                return TxnResult(TxnStatus::INSUFFICIENT_FUNDS);
+            }
+        
+            // BEGIN TRANSACTION WITH ROLLBACK CAPABILITY (PRODUCTION FIX #4)
+            TransactionManager transaction_manager;
+            transaction_manager.beginTransaction();
+        
+            try {
+                // Snapshot accounts before changes
+                transaction_manager.snapshotAccount(from_acc, source->getBalanceInPaise());
+                transaction_manager.snapshotAccount(to_acc, destination->getBalanceInPaise());
+            
+                // Perform transfer operations
+                source->debit(amount_paise);
+                transaction_manager.updateAccountBalance(from_acc, source->getBalanceInPaise());
+            
+                destination->credit(amount_paise);
+                transaction_manager.updateAccountBalance(to_acc, destination->getBalanceInPaise());
+            
+                // Record transactions
+                source->recordTransaction(TransactionType::TRANSFER_OUT, amount_paise, "Transfer to " + to_string(to_acc));
+                destination->recordTransaction(TransactionType::TRANSFER_IN, amount_paise, "Transfer from " + to_string(from_acc));
+            
+                // Commit transaction
+                transaction_manager.commit();
+            
+            } catch (const exception& e) {
+                // AUTOMATIC ROLLBACK ON ANY ERROR
+                restoreBalances(transaction_manager.rollback());
+            
+                Logger::getInstance().error("Transfer failed and rolled back: " + string(e.what()));
+                throw;
+            }
+        
+            WriteAheadLog::PendingCommit pending = logCommit({from_acc, to_acc});
+            account_locks.release();
+            awaitCommit(pending);
+        }
+        
+        checkpointIfRequested();
+        return TxnResult(TxnStatus::OK, amount_paise);
+    }
+    
+    // Throwing form of tryTransfer for callers that treat a decline as an error.
+    void executeTransfer(int from_acc, int to_acc, long long amount_paise) {
+        TxnResult result = tryTransfer(from_acc, to_acc, amount_paise);
+        switch (result.status) {
+            case TxnStatus::OK:
+                return;
+            case TxnStatus::ACCOUNT_NOT_FOUND:
+                throwTxnStatus(result.status, findAccount(from_acc) ? "Destination account " + to_string(to_acc) 
+                                                                    : "Source account " + to_string(from_acc));
+            case TxnStatus::SAME_ACCOUNT:
+                throwTxnStatus(result.status, "Cannot transfer to the same account " + to_string(from_acc));
+            case TxnStatus::INVALID_AMOUNT:
+                throwTxnStatus(result.status, "Transfer amount " + MoneyUtils::formatCurrency(amount_paise) + 
+                                              " outside permitted limits");
+            default:
+                throwTxnStatus(result.status, "Cannot debit " + MoneyUtils::formatCurrency(amount_paise) + 
+                                              " from account " + to_string(from_acc));
+        }
+    }
+    
+    void applyMonthlyInterest() {
+        User* current_user = getCurrentUser();
+        if (!current_user || !current_user->isAdmin()) {
+            cout << "❌ Admin access required for this operation!" << endl;
+            return;
+        }
+        
+        cout << "\n=== 📈 APPLYING MONTHLY INTEREST ===" << endl;
+        InterestEngine::Result result = runMonthEndInterest();
+        
+        cout << "\n📊 Interest applied to " << result.accounts_credited << " savings accounts." << endl;
+        cout << "💰 Total interest credited: " << MoneyUtils::formatCurrency(result.total_interest_paise) << endl;
+        cout << "⏱️ Completed in " << fixed << setprecision(3) << result.elapsed_seconds << " s using " 
+             << result.threads_used << " threads" << endl;
+    }
+    
+    // Credits interest to every savings account. Other operations are held
+    // off for the duration so the following checkpoint captures one
+    // consistent month-end state. Interest postings are not in the WAL, so
+    // that checkpoint rewrites the accounts file atomically.
+    InterestEngine::Result runMonthEndInterest() {
+        ScopedLatency latency(LatencyMetric::MONTHLY_INTEREST);
+        InterestEngine::Result result;
+        {
+            unique_lock<shared_mutex> gate(persistence_gate);
+            result = InterestEngine::run(accounts, ThreadPool::resolveThreadCount(config->getInt("savings.interest_threads", 0)),
+                                         config->snapshot().data_directory);
+        }
+        
+        if (result.accounts_credited > 0) {
+            checkpoint();
+        }
+        return result;
+    }
+    
+    void manageAccount(int acc_no) {
+        Account* account = findAccount(acc_no);
+        if (!account) {
+            cout << "❌ Account not found!" << endl;
+            return;
+        }
+        
+        if (!canAccessAccount(acc_no)) {
+            cout << "❌ You don't have access to this account!" << endl;
+            return;
+        }
+        
+        if (!auth_manager.authenticate(acc_no)) {
+            return;
+        }
+        
+        int op_choice;
+        do {
+            showOperationsMenu();
+            op_choice = InputValidator::getValidChoice("Enter your choice: ", 1, 10);
+            
+            switch (op_choice) {
+                case 1:
+                    account->displayAccountInfo();
+                    break;
+                case 2:
+                    account->processDeposit();
+                    commitAccounts({acc_no});
+                    break;
+                case 3:
+                    account->processWithdrawal();
+                    commitAccounts({acc_no});
+                    break;
+                case 4:
+                    account->showTransactionHistory();
+                    break;
+                case 5:
+                    account->showTransactionHistory(20, TransactionType::DEPOSIT);
+                    break;
+                case 6:
+                    account->showTransactionHistory(20, TransactionType::WITHDRAWAL);
+                    break;
+                case 7:
+                    account->generateAccountStatement();
+                    break;
+                case 8: {
+                    string filename = "statement_" + to_string(acc_no) + "_" + 
+                                     to_string(TimeUtils::getCurrentUTC()) + ".csv";
+                    exportAccountStatement(*account, filename);
+                    break;
+                }
+                case 9: {
+                    time_t from_time, to_time;
+                    string from_date = InputValidator::getValidString("Enter start date (YYYY-MM-DD): ");
+                    string to_date = InputValidator::getValidString("Enter end date (YYYY-MM-DD): ");
+                    if (!TimeUtils::parseDateUTC(from_date, from_time) || !TimeUtils::parseDateUTC(to_date, to_time)) {
+                        cout << "❌ Invalid date. Use the format YYYY-MM-DD." << endl;
+                        break;
+                    }
+                    if (to_time < from_time) {
+                        cout << "❌ End date is before start date." << endl;
+                        break;
+                    }
+                    account->showStatementForRange(from_time, to_time + 86399);
+                    break;
+                }
+                case 10:
+                    break;
+                default:
+                    cout << "❌ Invalid choice." << endl;
+            }
+        } while (op_choice != 10);
+    }
+    
+    void exportAccountStatement(const Account& account, const string& filename) {
+        ofstream file(filename);
+        if (file.is_open()) {
+            file << "=== ACCOUNT STATEMENT ===" << endl;
+            file << "Account Number: " << account.getAccountNumber() << endl;
+            file << "Name: " << account.getName() << endl;
+            file << "Current Balance: " << MoneyUtils::formatCurrency(account.getBalanceInPaise()) << endl;
+            file << "Account Type: " << accountTypeToString(account.getAccountType()) << endl;
+            file << "Statement Generated: " << TimeUtils::getCurrentTimestampUTC() << endl;
+            file << "\nTransaction History:" << endl;
+            file << "TXN_ID,Type,Amount_Paise,Balance_After_Paise,Timestamp_UTC,Description" << endl;
+            
+            for (const auto& trans : account.getTransactionHistory()) {
+                file << TransactionIdGenerator::format(trans.getTransactionId()) << ","
+                     << transactionTypeToString(trans.getType()) << ","
+                     << trans.getAmountInPaise() << ","
+                     << trans.getBalanceAfterInPaise() << ","
+                     << trans.getTimestamp() << ","
+                     << trans.getDescription() << endl;
+            }
+            file.close();
+            cout << "📄 Statement exported to " << filename << endl;
+            Logger::getInstance().info("Statement exported for account " + to_string(account.getAccountNumber()) + 
+                                      " to " + filename);
+        } else {
+            cout << "❌ Error: Could not export statement." << endl;
+            Logger::getInstance().error("Failed to export statement for account " + to_string(account.getAccountNumber()));
+        }
+    }
+    
+    void listUserAccounts() {
+        User* current_user = getCurrentUser();
+        if (current_user) {
+            cout << "\n📋 Your Accounts:" << endl;
+            const auto& owned_accounts = current_user->getOwnedAccounts();
+            if (owned_accounts.empty()) {
+                cout << "No accounts found." << endl;
+                return;
+            }
+            
+            cout << left << setw(12) << "Account No" << setw(20) << "Name" 
+                 << setw(12) << "Type" << setw(15) << "Balance" << "Phone" << endl;
+            cout << string(70, '-') << endl;
+            
+            for (int acc_no : owned_accounts) {
+                Account* acc = findAccount(acc_no);
+                if (acc) {
+                    cout << left << setw(12) << acc_no << setw(20) << acc->getName().substr(0, 18)
+                         << setw(12) << accountTypeToString(acc->getAccountType()) 
+                         << setw(15) << MoneyUtils::formatCurrency(acc->getBalanceInPaise())
+                         << acc->getPhoneNumber() << endl;
+                }
+            }
+        } else {
+            cout << "\n👤 Guest Mode - Limited Access" << endl;
+            cout << "Please login to view detailed account information." << endl;
+            cout << "Total accounts in system: " << accounts.size() << endl;
+        }
+    }
+    
+    void run() {
+        cout << "🏦 Welcome to Enterprise Banking System v6.0 - Production Ready" << endl;
+        cout << "=================================================================" << endl;
+        cout << "✅ Features: Monetary Precision, UTC Timestamps, Transaction Rollback, Thread Safety" << endl;
+        
+        if (!userLogin()) {
+            cout << "❌ Login failed. Exiting..." << endl;
+            return;
+        }
+        
+        int choice;
+        do {
+            showMainMenu();
+            choice = InputValidator::getValidChoice("Enter your choice: ", 0, 15);
+            
+            switch (choice) {
+                case 1:
+                    createAccount(AccountType::SAVINGS);
+                    break;
+                case 2:
+                    createAccount(AccountType::CURRENT);
+                    break;
+                case 3:
+                    createAccount(AccountType::LOAN);
+                    break;
+                case 4: {
+                    int acc_no = InputValidator::getValidAccountNumber("Enter account number to manage: ");
+                    manageAccount(acc_no);
+                    break;
+                }
+                case 5:
+                    transferMoney();
+                    break;
+                case 6:
+                    listUserAccounts();
+                    break;
+                case 7:
+                    exportAllAccountData();
+                    break;
+                case 8:
+                    applyMonthlyInterest();
+                    break;
+                case 9:
+                    adminMenu();
+                    break;
+                case 10:
+                    showSystemStatistics();
+                    break;
+                case 11:
+                    saveAllData();
+                    cout << "💾 All data saved successfully!" << endl;
+                    break;
+                case 0:
+                    cout << "\n🙏 Thank you for banking with us!" << endl;
+                    break;
+                default:
+                    cout << "❌ Invalid choice. Please try again." << endl;
+            }
+        } while (choice != 0);
+    }
+    
+private:
+    void showMainMenu() {
+        User* current_user = getCurrentUser();
+        
+        cout << "\n=== 🏦 MAIN MENU ===" << endl;
+        cout << "1. Create Savings Account" << endl;
+        cout << "2. Create Current Account" << endl;
+        cout << "3. Create Loan Account" << endl;
+        cout << "4. Manage Account" << endl;
+        cout << "5. Transfer Money (2FA Required)" << endl;
+        cout << "6. List " << (current_user ? "My" : "All") << " Accounts" << endl;
+        cout << "7. Export Account Data" << endl;
+        cout << "8. Apply Monthly Interest" << (current_user && current_user->isAdmin() ? "" : " (Admin Only)") << endl;
+        cout << "9. Admin Menu" << (current_user && current_user->isAdmin() ? "" : " (Admin Only)") << endl;
+        cout << "10. System Statistics" << endl;
+        cout << "11. Save All Data" << endl;
+        cout << "0. Exit" << endl;
+        
+        if (current_user) {
+            cout << "\n👤 Logged in as: " << current_user->getUsername() 
+                 << " [" << (current_user->isAdmin() ? "ADMIN" : "USER") << "]" << endl;
+        } else {
+            cout << "\n👤 Mode: Guest (Limited Access)" << endl;
+        }
+    }
+    
+    void showOperationsMenu() {
+        cout << "\n--- 💳 Account Operations ---" << endl;
+        cout << "1. Display Account Details" << endl;
+        cout << "2. Deposit Money" << endl;
+        cout << "3. Withdraw Money" << endl;
+        cout << "4. View Transaction History" << endl;
+        cout << "5. View Deposits Only" << endl;
+        cout << "6. View Withdrawals Only" << endl;
+        cout << "7. Generate Account Statement" << endl;
+        cout << "8. Export Statement to File" << endl;
+        cout << "9. Statement for Date Range" << endl;
+        cout << "10. Back to Main Menu" << endl;
+    }
+    
+    void exportAllAccountData() {
+        User* current_user = getCurrentUser();
+        if (!current_user) {
+            cout << "❌ Please login to export data." << endl;
+            return;
+        }
+        
+        const auto& owned_accounts = current_user->getOwnedAccounts();
+        if (owned_accounts.empty()) {
+            cout << "No accounts to export." << endl;
+            return;
+        }
+        
+        string timestamp = to_string(TimeUtils::getCurrentUTC());
+        for (int acc_no : owned_accounts) {
+            Account* acc = findAccount(acc_no);
+            if (acc) {
+                string filename = "statement_" + accountTypeToString(acc->getAccountType()) + "_" + 
+                                 to_string(acc_no) + "_" + timestamp + ".csv";
+                exportAccountStatement(*acc, filename);
+            }
+        }
+        cout << "📄 Export completed for " << owned_accounts.size() << " accounts." << endl;
+    }
+    
+    void adminMenu() {
+        User* current_user = getCurrentUser();
+        if (!current_user || !current_user->isAdmin()) {
+            cout << "❌ Admin access required!" << endl;
+            return;
+        }
+        
+        cout << "\n=== 👑 ADMIN MENU ===" << endl;
+        cout << "1. Unlock Account" << endl;
+        cout << "2. Apply Monthly Interest to All Savings" << endl;
+        cout << "3. View All Accounts in System" << endl;
+        cout << "4. Create Admin User" << endl;
+        cout << "5. System Configuration" << endl;
+        cout << "6. Find Transaction by ID" << endl;
+        cout << "7. Operation Latency Histograms" << endl;
+        cout << "9. Back to Main Menu" << endl;
+        
+        int choice = InputValidator::getValidChoice("Enter admin choice: ", 1, 9);
+        
+        switch (choice) {
+            case 1: {
+                int acc_no = InputValidator::getValidAccountNumber("Enter account number to unlock: ");
+                auth_manager.unlockAccount(acc_no);
+                break;
+            }
+            case 2:
+                applyMonthlyInterest();
+                break;
+            case 3: {
+                string saved_username = current_username;
+                
+                cout << "\n=== 📊 ALL SYSTEM ACCOUNTS ===" << endl;
+                cout << left << setw(12) << "Account No" << setw(20) << "Name" 
+                     << setw(12) << "Type" << setw(15) << "Balance" << "Phone" << endl;
+                cout << string(70, '-') << endl;
+                
+                for (const Account* acc : accounts.getAllAccounts()) {
+                    cout << left << setw(12) << acc->getAccountNumber() << setw(20) << acc->getName().substr(0, 18)
+                         << setw(12) << accountTypeToString(acc->getAccountType()) 
+                         << setw(15) << MoneyUtils::formatCurrency(acc->getBalanceInPaise())
+                         << acc->getPhoneNumber() << endl;
+                }
+                
+                current_username = saved_username;
+                break;
+            }
+            case 4: {
+                string username = InputValidator::getValidString("Enter new admin username: ");
+                if (users.find(username) != users.end()) {
+                    cout << "❌ Username already exists!" << endl;
+                } else {
+                    string password = InputValidator::getValidString("Enter admin password: ");
+                    User new_admin(username, password, UserRole::ADMIN);
+                    users[username] = new_admin;
+                    saveAllData();
+                    cout << "✅ Admin user created successfully!" << endl;
+                }
+                break;
+            }
+            case 5: {
+                const ConfigSnapshot& snapshot = config->snapshot();
+                cout << "⚙️ Config file: " << config->getConfigFilePath() << " (generation " << snapshot.generation 
+                     << ", hot reload " << (config->getInt("config.hot_reload", 1) != 0 ? "on" : "off") << ")" << endl;
+                for (const auto& warning : snapshot.warnings) {
+                    cout << "⚠️ " << warning << endl;
+                }
+                if (InputValidator::getValidChoice("Reload now? (1-Yes, 0-No): ", 0, 1) == 1) {
+                    cout << (config->reload() ? "✅ Configuration reloaded (generation " + 
+                                                to_string(config->snapshot().generation) + ")" 
+                                              : "❌ Configuration file could not be read") << endl;
+                }
+                break;
+            }
+            case 6: {
+                string txn_text = InputValidator::getValidString("Enter transaction ID (e.g. TXN123...): ");
+                uint64_t transaction_id = TransactionIdGenerator::parse(txn_text);
+                int account_no = 0;
+                string record;
+                
+                if (transaction_id == 0 || !findTransaction(transaction_id, account_no, record)) {
+                    cout << "❌ Transaction " << txn_text << " not found in index (run --rebuild-txn-index if it should exist)." << endl;
+                    break;
+                }
+                
+                try {
+                    Transaction transaction = Transaction::fromCSV(record);
+                    cout << "\n🔎 Transaction found in account " << account_no << ":" << endl;
+                    transaction.display();
+                } catch (const exception& e) {
+                    cout << "❌ Index entry for " << txn_text << " is stale - run --rebuild-txn-index" << endl;
+                    Logger::getInstance().error("Stale transaction index entry for " + txn_text + ": " + e.what());
+                }
+                break;
+            }
+            case 7: {
+                cout << "\n=== ⏱️ OPERATION LATENCY ===" << endl;
+                if (!LatencyHistograms::isEnabled()) {
+                    cout << "(recording is off - set metrics.latency_histograms=1)" << endl;
+                }
+                LatencyHistograms::printReport(cout);
+                if (InputValidator::getValidChoice("Dump full histograms to a file? (1-Yes, 0-No): ", 0, 1) == 1) {
+                    string filename = config->getString("directory.logs", "logs") + "/latency_" + 
+                                      to_string(TimeUtils::getCurrentUTC()) + ".txt";
+                    cout << (LatencyHistograms::dumpToFile(filename) ? "📄 Histograms written to " + filename 
+                                                                     : "❌ Cannot write " + filename) << endl;
+                }
+                break;
+            }
+            case 9:
+                break;
+        }
+    }
+    
+    void showSystemStatistics() {
+        cout << "\n=== 📊 SYSTEM STATISTICS ===" << endl;
+        
+        int admin_count = 0, user_count = 0;
+        for (const auto& pair : users) {
+            if (pair.second.isAdmin()) {
+                admin_count++;
+            } else {
+                user_count++;
+            }
+        }
+        
+        cout << "👥 Users: " << users.size() << " (Admins: " << admin_count 
+             << ", Regular: " << user_count << ")" << endl;
+        
+        // Maintained on every commit, so this stays O(1) in the number of accounts
+        SystemAggregates::Snapshot aggregates = SystemAggregates::getInstance().read();
+        const AggregateContribution& totals = aggregates.totals;
+        
+        cout << "\n💳 Accounts:" << endl;
+        cout << "  Savings: " << totals.savings_accounts << endl;
+        cout << "  Current: " << totals.current_accounts << endl;
+        cout << "  Loan: " << totals.loan_accounts << endl;
+        cout << "  Total: " << accounts.size() << endl;
+        
+        cout << "\n💰 Financial Overview:" << endl;
+        cout << "  Total Deposits: " << MoneyUtils::formatCurrency(totals.deposits_paise) << endl;
+        cout << "  Outstanding Loans: " << MoneyUtils::formatCurrency(totals.loans_paise) << endl;
+        cout << "  Overdraft Used: " << MoneyUtils::formatCurrency(totals.overdraft_used_paise) 
+             << " of " << MoneyUtils::formatCurrency(totals.overdraft_cap_paise);
+        if (totals.overdraft_cap_paise > 0) {
+            cout << " (" << fixed << setprecision(1) 
+                 << 100.0 * totals.overdraft_used_paise / totals.overdraft_cap_paise << "%)";
+        }
+        cout << endl;
+        
+        size_t total_transactions = TransactionIdIndex::getInstance().size();
+        cout << "\n📈 Transaction Activity:" << endl;
+        cout << "  Total Transactions: " << total_transactions << endl;
+        cout << "  Average per Account: " << fixed << setprecision(1) 
+             << (accounts.empty() ? 0 : (double)total_transactions / accounts.size()) << endl;
+        cout << "  Since startup by type:" << endl;
+        for (size_t i = 0; i < SystemAggregates::TRANSACTION_TYPE_COUNT; i++) {
+            if (aggregates.transactions_by_type[i] > 0) {
+                cout << "    " << left << setw(22) << transactionTypeToString(static_cast<TransactionType>(i)) 
+                     << right << aggregates.transactions_by_type[i] << endl;
+            }
+        }
+        
+        printStartupReport();
+        Durability::printReport();
+        
+        cout << "\n🖥️ System Health:" << endl;
+        cout << "  Next Account Number: " << AccountManager::getNextAccountNumber() + 1 << endl;
+        cout << "  Configuration Status: ✅ Active" << endl;
+        cout << "  Logging Status: ✅ Active (UTC)" << endl;
+        cout << "  Transaction Manager: ✅ Ready" << endl;
+    }
+};
+
+// =============================================================================
+// HEADLESS BATCH TRANSACTION PROCESSOR
+// =============================================================================
+//
+// Applies a command file through the same business rules as the menus:
+//
+//   deposit  <account> <amount>
+//   withdraw <account> <amount>
+//   transfer <from> <to> <amount>
+//   emi      <account> [amount]      (defaults to the account's EMI)
+//   interest <account>
+//
+// Amounts are in rupees. Blank lines and lines starting with '#' are ignored.
+
+class BatchProcessor {
+public:
+    struct Summary {
+        map<string, int> applied_by_command;
+        map<string, int> rejected_by_command;
+        int applied;
+        int rejected;
+        int malformed;
+        double elapsed_seconds;
+        
+        Summary() : applied(0), rejected(0), malformed(0), elapsed_seconds(0.0) {}
+    };
+    
+    // Parses a rupee amount token; shared with the daemon protocol.
+    // Rejects inf, nan and anything too large for paise before converting;
+    // rupeesToPaise would overflow on them.
+    static long long parseAmount(const string& token) {
+        size_t consumed = 0;
+        double rupees = 0.0;
+        try {
+            rupees = stod(token, &consumed);
+        } catch (const out_of_range&) {
+            throw invalid_argument("bad amount '" + token + "'");
+        }
+        if (consumed != token.size() || !isfinite(rupees) || rupees < 0 || 
+            rupees >= static_cast<double>(LLONG_MAX) / 100.0) {
+            throw invalid_argument("bad amount '" + token + "'");
+        }
+        return MoneyUtils::rupeesToPaise(rupees);
+    }
+    
+private:
+    BankingSystem& bank;
+    
+    // Applies one command. Business declines come back as a status; syntax
+    // errors throw invalid_argument and real faults propagate as exceptions.
+    TxnStatus apply(const string& command, istringstream& args) {
+        if (command == "deposit" || command == "withdraw") {
+            int acc_no;
+            string amount_token;
+            if (!(args >> acc_no >> amount_token)) throw invalid_argument("expected <account> <amount>");
+            long long amount_paise = parseAmount(amount_token);
+            if (!InputValidator::isValidAmount(amount_paise)) return TxnStatus::INVALID_AMOUNT;
             
-            cout << "\n📋 Transfer Details:" << endl;
-            cout << "From: " << source->getName() << " (Account: " << from_acc << ")" << endl;
-            cout << "To: " << destination->getName() << " (Account: " << to_acc << ")" << endl;
-            cout << "Amount: " << MoneyUtils::formatCurrency(amount_paise) << endl;
+            bool is_deposit = (command == "deposit");
+            return bank.tryAccountOperation(acc_no, [is_deposit, amount_paise](Account& account) {
+                return TxnResult(is_deposit ? account.tryDeposit(amount_paise) : account.tryWithdraw(amount_paise), 
+                                 amount_paise);
+            }).status;
             
-            int confirm = InputValidator::getValidChoice("✅ Confirm transfer? (1-Yes, 0-No): ", 0, 1);
-            if (confirm == 0) {
-                transaction_manager.rollback();
-                cout << "❌ Transfer cancelled." << endl;
-                return;
+        } else if (command == "transfer") {
+            int from_acc, to_acc;
+            string amount_token;
+            if (!(args >> from_acc >> to_acc >> amount_token)) throw invalid_argument("expected <from> <to> <amount>");
+            return bank.tryTransfer(from_acc, to_acc, parseAmount(amount_token)).status;
+            
+        } else if (command == "emi") {
+            int acc_no;
+            if (!(args >> acc_no)) throw invalid_argument("expected <account> [amount]");
+            string amount_token;
+            bool has_amount = static_cast<bool>(args >> amount_token);
+            long long requested_paise = has_amount ? parseAmount(amount_token) : 0;
+            
+            return bank.tryAccountOperation(acc_no, [has_amount, requested_paise](Account& account) {
+                LoanAccount* loan_acc = dynamic_cast<LoanAccount*>(&account);
+                if (!loan_acc) return TxnResult(TxnStatus::NOT_PERMITTED);
+                long long amount_paise = has_amount ? requested_paise : loan_acc->getEMIAmountInPaise();
+                if (!InputValidator::isValidAmount(amount_paise)) return TxnResult(TxnStatus::INVALID_AMOUNT);
+                return loan_acc->tryMakePayment(amount_paise);
+            }).status;
+            
+        } else if (command == "interest") {
+            int acc_no;
+            if (!(args >> acc_no)) throw invalid_argument("expected <account>");
+            return bank.tryAccountOperation(acc_no, [](Account& account) {
+                SavingsAccount* savings_acc = dynamic_cast<SavingsAccount*>(&account);
+                if (!savings_acc) return TxnResult(TxnStatus::NOT_PERMITTED);
+                return TxnResult(TxnStatus::OK, savings_acc->creditMonthlyInterest());
+            }).status;
+            
+        } else {
+            throw invalid_argument("unknown command '" + command + "'");
+        }
+    }
+    
+public:
+    BatchProcessor(BankingSystem& banking_system) : bank(banking_system) {}
+    
+    Summary run(const string& filename) {
+        Summary summary;
+        
+        ifstream file(filename);
+        if (!file.is_open()) {
+            throw DataIntegrityException("Cannot open batch file: " + filename);
+        }
+        
+        Logger::getInstance().info("Batch run started: " + filename);
+        auto start_time = chrono::steady_clock::now();
+        
+        string line;
+        int line_number = 0;
+        while (getline(file, line)) {
+            line_number++;
+            size_t first = line.find_first_not_of(" \t\r");
+            if (first == string::npos || line[first] == '#') continue;
+            
+            istringstream args(line);
+            string command;
+            args >> command;
+            transform(command.begin(), command.end(), command.begin(), ::tolower);
+            
+            try {
+                TxnStatus status = apply(command, args);
+                if (status == TxnStatus::OK) {
+                    summary.applied_by_command[command]++;
+                    summary.applied++;
+                } else {
+                    summary.rejected_by_command[command]++;
+                    summary.rejected++;
+                    Logger::getInstance().warning("Batch line " + to_string(line_number) + " declined: " + 
+                                                 txnStatusToString(status));
+                }
+            } catch (const invalid_argument& e) {
+                summary.malformed++;
+                Logger::getInstance().warning("Batch line " + to_string(line_number) + " malformed: " + e.what());
+            } catch (const out_of_range& e) {
+                summary.malformed++;
+                Logger::getInstance().warning("Batch line " + to_string(line_number) + " malformed: " + e.what());
+            } catch (const exception& e) {
+                summary.rejected_by_command[command]++;
+                summary.rejected++;
+                Logger::getInstance().warning("Batch line " + to_string(line_number) + " rejected: " + e.what());
+            }
+        }
+        
+        summary.elapsed_seconds = chrono::duration<double>(chrono::steady_clock::now() - start_time).count();
+        Logger::getInstance().info("Batch run finished: " + to_string(summary.applied) + " applied, " + 
+                                  to_string(summary.rejected) + " rejected, " + to_string(summary.malformed) + " malformed");
+        return summary;
+    }
+    
+    static void printSummary(const Summary& summary) {
+        int total = summary.applied + summary.rejected;
+        
+        cout << "\n=== 📦 BATCH SUMMARY ===" << endl;
+        cout << left << setw(12) << "Command" << setw(10) << "Applied" << "Rejected" << endl;
+        cout << string(30, '-') << endl;
+        for (const char* command : {"deposit", "withdraw", "transfer", "emi", "interest"}) {
+            auto applied_it = summary.applied_by_command.find(command);
+            auto rejected_it = summary.rejected_by_command.find(command);
+            int applied = applied_it != summary.applied_by_command.end() ? applied_it->second : 0;
+            int rejected = rejected_it != summary.rejected_by_command.end() ? rejected_it->second : 0;
+            if (applied + rejected == 0) continue;
+            cout << left << setw(12) << command << setw(10) << applied << rejected << endl;
+        }
+        cout << string(30, '-') << endl;
+        cout << "Applied:   " << summary.applied << endl;
+        cout << "Rejected:  " << summary.rejected << endl;
+        cout << "Malformed: " << summary.malformed << endl;
+        cout << "Elapsed:   " << fixed << setprecision(3) << summary.elapsed_seconds << " s" << endl;
+        cout << "Throughput: " << fixed << setprecision(1)
+             << (summary.elapsed_seconds > 0 ? total / summary.elapsed_seconds : 0.0) << " ops/sec" << endl;
+    }
+};
+
+// =============================================================================
+// UNIX-DOMAIN-SOCKET DAEMON
+// =============================================================================
+//
+// Lets many local front-end processes share one in-memory bank. A single I/O
+// thread polls the listening socket and every connection; complete request
+// lines go to a worker pool, one at a time per connection so each client
+// receives its replies in order. Workers hand replies back to the I/O thread,
+// which writes them from a per-connection buffer as the non-blocking socket
+// accepts them, so a client that stops reading only stalls itself. Requests
+// are single lines of space-separated tokens (keywords are case-insensitive,
+// amounts are in rupees):
+//
+//   AUTH      <account> <pin>
+//   BALANCE   <account>
+//   DEPOSIT   <account> <amount>
+//   WITHDRAW  <account> <amount>
+//   TRANSFER  <from> <to> <amount>
+//   EMI       <account> [amount]      (defaults to the account's EMI)
+//   STATEMENT <account> [count]       (newest first, default 10)
+//   PING | QUIT
+//
+// Every reply is "OK [fields]" or "ERR <code> [message]". STATEMENT replies
+// "OK <n>" followed by n records in the transaction file format. An account
+// must be AUTHed on the connection before use; a transfer needs only its
+// source account. Declines use the TxnStatus names as their codes.
+
+#ifdef BANKING_POSIX
+
+class BankingDaemon {
+private:
+    static constexpr size_t MAX_REQUEST_BYTES = 4096;
+    static constexpr size_t MAX_PENDING_REQUESTS = 256;
+    static constexpr size_t MAX_OUTBOUND_BYTES = 64 * 1024;
+    static constexpr size_t DEFAULT_STATEMENT_COUNT = 10;
+    
+    struct Session {
+        int fd;
+        string inbound;
+        queue<string> pending;       // I/O thread only
+        string outbound;             // I/O thread only: replies not yet accepted by the socket
+        bool busy = false;           // I/O thread only
+        bool closing = false;        // I/O thread only
+        vector<int> authenticated;   // the worker serving this session only
+        
+        explicit Session(int socket_fd) : fd(socket_fd) {}
+    };
+    
+    struct Completion {
+        shared_ptr<Session> session;
+        string reply;
+        bool close_after;
+    };
+    
+    static atomic<bool> stop_requested;
+    static int signal_wake_fd;
+    
+    BankingSystem& bank;
+    ConfigManager& config;
+    string socket_path;
+    int listen_fd;
+    int wake_pipe[2];
+    unordered_map<int, shared_ptr<Session>> sessions;
+    mutex completed_mutex;
+    vector<Completion> completed;
+    deque<future<void>> auth_jobs;   // I/O thread only; drained before run() returns
+    atomic<long long> requests_served;
+    
+    static void handleSignal(int) {
+        stop_requested.store(true);
+        if (signal_wake_fd >= 0) {
+            char byte = 's';
+            ssize_t ignored = write(signal_wake_fd, &byte, 1);
+            (void)ignored;
+        }
+    }
+    
+    void wake() {
+        char byte = 'w';
+        ssize_t ignored = write(wake_pipe[1], &byte, 1);
+        (void)ignored;
+    }
+    
+    // Writes as much buffered output as the socket accepts without blocking.
+    // A failed send means the peer is gone: its remaining work is dropped.
+    static void flushOutbound(Session& session) {
+        size_t sent = 0;
+        while (sent < session.outbound.size()) {
+            ssize_t written = send(session.fd, session.outbound.data() + sent, session.outbound.size() - sent, 0);
+            if (written < 0) {
+                if (errno == EINTR) continue;
+                if (errno != EAGAIN && errno != EWOULDBLOCK) {
+                    session.outbound.clear();
+                    session.pending = queue<string>();
+                    session.closing = true;
+                    return;
+                }
+                break;
+            }
+            sent += static_cast<size_t>(written);
+        }
+        session.outbound.erase(0, sent);
+    }
+    
+    static string formatRupees(long long paise) {
+        string sign = paise < 0 ? "-" : "";
+        unsigned long long magnitude = paise < 0 ? 0ULL - static_cast<unsigned long long>(paise) 
+                                                 : static_cast<unsigned long long>(paise);
+        string fraction = to_string(magnitude % 100);
+        return sign + to_string(magnitude / 100) + "." + (fraction.size() < 2 ? "0" : "") + fraction;
+    }
+    
+    static string ok(const string& fields = "") {
+        return fields.empty() ? "OK\n" : "OK " + fields + "\n";
+    }
+    
+    static string error(const string& code, const string& message = "") {
+        return "ERR " + code + (message.empty() ? "" : " " + message) + "\n";
+    }
+    
+    static int parseAccount(istringstream& args) {
+        string token;
+        if (!(args >> token)) throw invalid_argument("missing account number");
+        int acc_no = 0;
+        auto parsed = from_chars(token.data(), token.data() + token.size(), acc_no);
+        if (parsed.ec != errc() || parsed.ptr != token.data() + token.size()) {
+            throw invalid_argument("bad account number '" + token + "'");
+        }
+        return acc_no;
+    }
+    
+    static long long parseAmount(istringstream& args) {
+        string token;
+        if (!(args >> token)) throw invalid_argument("missing amount");
+        return parseAmountToken(token);
+    }
+    
+    static long long parseAmountToken(const string& token) {
+        try {
+            return BatchProcessor::parseAmount(token);
+        } catch (const logic_error&) {
+            throw invalid_argument("bad amount '" + token + "'");
+        }
+    }
+    
+    static bool isAuthenticated(const Session& session, int acc_no) {
+        return find(session.authenticated.begin(), session.authenticated.end(), acc_no) != session.authenticated.end();
+    }
+    
+    static string notAuthenticated(int acc_no) {
+        return error("UNAUTHENTICATED", "account " + to_string(acc_no) + " not authenticated on this connection");
+    }
+    
+    string authenticate(Session& session, istringstream& args) {
+        int acc_no = parseAccount(args);
+        string pin;
+        if (!(args >> pin)) throw invalid_argument("missing PIN");
+        
+        switch (bank.getAuthenticationManager().verifyPin(acc_no, pin)) {
+            case PinCheck::OK:
+                if (!isAuthenticated(session, acc_no)) {
+                    session.authenticated.push_back(acc_no);
+                }
+                return ok();
+            case PinCheck::NO_PIN:
+                return error("NO_PIN", "no PIN registered for account " + to_string(acc_no));
+            case PinCheck::LOCKED:
+                return error("LOCKED", "account " + to_string(acc_no) + " is locked");
+            default:
+                return error("WRONG_PIN");
+        }
+    }
+    
+    string execute(Session& session, const string& command, istringstream& args) {
+        if (command == "AUTH") {
+            return authenticate(session, args);
+        }
+        if (command == "PING") {
+            return ok("PONG");
+        }
+        
+        int acc_no = parseAccount(args);
+        if (!isAuthenticated(session, acc_no)) {
+            return notAuthenticated(acc_no);
+        }
+        
+        if (command == "BALANCE") {
+            long long balance_paise = 0;
+            if (!bank.readAccount(acc_no, [&balance_paise](const Account& account) {
+                    balance_paise = account.getBalanceInPaise();
+                })) {
+                return error(txnStatusToString(TxnStatus::ACCOUNT_NOT_FOUND));
             }
+            return ok(formatRupees(balance_paise));
             
-            // Snapshot accounts before changes
-            transaction_manager.snapshotAccount(from_acc, source->getBalanceInPaise());
-            transaction_manager.snapshotAccount(to_acc, destination->getBalanceInPaise());
+        } else if (command == "DEPOSIT" || command == "WITHDRAW") {
+            long long amount_paise = parseAmount(args);
+            if (!InputValidator::isValidAmount(amount_paise)) {
+                return error(txnStatusToString(TxnStatus::INVALID_AMOUNT));
+            }
+            bool is_deposit = (command == "DEPOSIT");
+            long long balance_paise = 0;
+            TxnResult result = bank.tryAccountOperation(acc_no, [&](Account& account) {
+                TxnStatus status = is_deposit ? account.tryDeposit(amount_paise) : account.tryWithdraw(amount_paise);
+                balance_paise = account.getBalanceInPaise();
+                return TxnResult(status, amount_paise);
+            });
+            return result.ok() ? ok(formatRupees(balance_paise)) : error(txnStatusToString(result.status));
             
-            // Perform transfer operations
-            source->debit(amount_paise);
-            transaction_manager.updateAccountBalance(from_acc, source->getBalanceInPaise());
+        } else if (command == "TRANSFER") {
+            int to_acc = parseAccount(args);
+            long long amount_paise = parseAmount(args);
+            TxnResult result = bank.tryTransfer(acc_no, to_acc, amount_paise);
+            return result.ok() ? ok(formatRupees(result.amount_paise)) : error(txnStatusToString(result.status));
             
-            destination->credit(amount_paise);
-            transaction_manager.updateAccountBalance(to_acc, destination->getBalanceInPaise());
+        } else if (command == "EMI") {
+            string amount_token;
+            long long requested_paise = (args >> amount_token) ? parseAmountToken(amount_token) : -1;
+            long long outstanding_paise = 0;
+            TxnResult result = bank.tryAccountOperation(acc_no, [&](Account& account) {
+                LoanAccount* loan_acc = dynamic_cast<LoanAccount*>(&account);
+                if (!loan_acc) {
+                    return TxnResult(TxnStatus::NOT_PERMITTED);
+                }
+                long long amount_paise = requested_paise >= 0 ? requested_paise : loan_acc->getEMIAmountInPaise();
+                if (!InputValidator::isValidAmount(amount_paise)) {
+                    return TxnResult(TxnStatus::INVALID_AMOUNT);
+                }
+                TxnResult payment = loan_acc->tryMakePayment(amount_paise);
+                outstanding_paise = loan_acc->getBalanceInPaise();
+                return payment;
+            });
+            return result.ok() ? ok(formatRupees(result.amount_paise) + " " + formatRupees(outstanding_paise)) 
+                               : error(txnStatusToString(result.status));
             
-            // Record transactions
-            source->recordTransaction(TransactionType::TRANSFER_OUT, amount_paise, "Transfer to " + to_string(to_acc));
-            destination->recordTransaction(TransactionType::TRANSFER_IN, amount_paise, "Transfer from " + to_string(from_acc));
+        } else if (command == "STATEMENT") {
+            size_t count = DEFAULT_STATEMENT_COUNT;
+            string count_token;
+            if (args >> count_token) {
+                count = static_cast<size_t>(stoul(count_token));
+            }
+            vector<string> records;
+            if (!bank.readAccount(acc_no, [&records, count](const Account& account) {
+                    const CircularBuffer<Transaction>& history = account.getTransactionHistory();
+                    for (auto it = history.rbegin(); it != history.rend() && records.size() < count; ++it) {
+                        records.push_back(it->toCSV());
+                    }
+                })) {
+                return error(txnStatusToString(TxnStatus::ACCOUNT_NOT_FOUND));
+            }
+            string reply = ok(to_string(records.size()));
+            for (const string& record : records) {
+                reply += record + "\n";
+            }
+            return reply;
+        }
+        
+        throw invalid_argument("unknown command '" + command + "'");
+    }
+    
+    static bool isAuthRequest(const string& line) {
+        istringstream args(line);
+        string command;
+        args >> command;
+        transform(command.begin(), command.end(), command.begin(), ::toupper);
+        return command == "AUTH";
+    }
+    
+    // Runs on a pool worker. Never throws: faults become ERR replies.
+    string handleRequest(Session& session, const string& line, bool& close_after) {
+        istringstream args(line);
+        string command;
+        args >> command;
+        transform(command.begin(), command.end(), command.begin(), ::toupper);
+        
+        if (command == "QUIT") {
+            close_after = true;
+            return ok("BYE");
+        }
+        
+        try {
+            return execute(session, command, args);
+        } catch (const invalid_argument& e) {
+            return error("BAD_REQUEST", e.what());
+        } catch (const out_of_range& e) {
+            return error("BAD_REQUEST", e.what());
+        } catch (const exception& e) {
+            Logger::getInstance().error("Daemon request failed: " + string(e.what()));
+            return error("INTERNAL", e.what());
+        }
+    }
+    
+    void dispatchNext(ThreadPool& pool, const shared_ptr<Session>& session) {
+        if (session->busy) {
+            return;
+        }
+        if (session->pending.empty()) {
+            if (session->closing && session->outbound.empty()) {
+                closeSession(session);
+            }
+            return;
+        }
+        // Requests wait while the client is not reading its replies
+        if (session->outbound.size() >= MAX_OUTBOUND_BYTES) {
+            return;
+        }
+        
+        string line = move(session->pending.front());
+        session->pending.pop();
+        session->busy = true;
+        auto job = [this, session, line]() {
+            bool close_after = false;
+            string reply = handleRequest(*session, line, close_after);
+            requests_served.fetch_add(1, memory_order_relaxed);
+            {
+                lock_guard<mutex> lock(completed_mutex);
+                completed.push_back({session, move(reply), close_after});
+            }
+            wake();
+        };
+        
+        // AUTH runs the password KDF, so it queues on the authentication pool
+        // and cannot tie up the workers serving transactions.
+        if (isAuthRequest(line)) {
+            while (!auth_jobs.empty() && auth_jobs.front().wait_for(chrono::seconds(0)) == future_status::ready) {
+                auth_jobs.pop_front();
+            }
+            auth_jobs.push_back(SecurityManager::submitAuthTask(job));
+        } else {
+            pool.submit(job);
+        }
+    }
+    
+    // Takes its own reference: the caller's may be the map entry being erased.
+    void closeSession(shared_ptr<Session> session) {
+        Logger::getInstance().debug("Daemon connection closed (fd " + to_string(session->fd) + ")");
+        sessions.erase(session->fd);
+        close(session->fd);
+    }
+    
+    void writeSession(ThreadPool& pool, const shared_ptr<Session>& session) {
+        flushOutbound(*session);
+        dispatchNext(pool, session);
+    }
+    
+    void readSession(ThreadPool& pool, const shared_ptr<Session>& session) {
+        char buffer[4096];
+        ssize_t received = recv(session->fd, buffer, sizeof(buffer), 0);
+        if (received < 0 && errno == EINTR) {
+            return;
+        }
+        if (received <= 0) {
+            session->closing = true;
+            dispatchNext(pool, session);
+            return;
+        }
+        
+        session->inbound.append(buffer, static_cast<size_t>(received));
+        size_t line_start = 0;
+        size_t newline;
+        while ((newline = session->inbound.find('\n', line_start)) != string::npos) {
+            string line = session->inbound.substr(line_start, newline - line_start);
+            line_start = newline + 1;
+            if (!line.empty() && line.back() == '\r') {
+                line.pop_back();
+            }
+            if (line.find_first_not_of(" \t") != string::npos) {
+                session->pending.push(move(line));
+            }
+        }
+        session->inbound.erase(0, line_start);
+        
+        if (session->inbound.size() > MAX_REQUEST_BYTES || session->pending.size() > MAX_PENDING_REQUESTS) {
+            Logger::getInstance().warning("Daemon dropping connection (fd " + to_string(session->fd) + 
+                                         "): request too long or too many pipelined requests");
+            session->inbound.clear();
+            session->pending = queue<string>();
+            session->closing = true;
+        }
+        dispatchNext(pool, session);
+    }
+    
+    void acceptConnections() {
+        size_t max_connections = static_cast<size_t>(max(1, config.getInt("daemon.max_connections", 256)));
+        while (true) {
+            int client_fd = accept(listen_fd, nullptr, nullptr);
+            if (client_fd < 0) {
+                if (errno == EINTR) continue;
+                return;  // EAGAIN: the backlog is drained
+            }
             
-            // Commit transaction
-            transaction_manager.commit();
+            if (sessions.size() >= max_connections) {
+                string refusal = error("BUSY", "too many connections");
+                ssize_t ignored = send(client_fd, refusal.data(), refusal.size(), 0);
+                (void)ignored;
+                close(client_fd);
+                Logger::getInstance().warning("Daemon refused a connection: limit of " + 
+                                             to_string(max_connections) + " reached");
+                continue;
+            }
             
-            cout << "\n✅ Transfer successful!" << endl;
-            cout << "💰 " << MoneyUtils::formatCurrency(amount_paise) << " transferred from Account " << from_acc 
-                 << " to Account " << to_acc << endl;
-            cout << "📊 New balance - Source: " << MoneyUtils::formatCurrency(source->getBalanceInPaise()) << endl;
-                 
-            saveAllData();
+            // Accepted sockets only inherit O_NONBLOCK on some platforms
+            fcntl(client_fd, F_SETFL, fcntl(client_fd, F_GETFL) | O_NONBLOCK);
+            sessions[client_fd] = make_shared<Session>(client_fd);
+            Logger::getInstance().debug("Daemon connection opened (fd " + to_string(client_fd) + ")");
+        }
+    }
+    
+    void processCompletions(ThreadPool& pool) {
+        char drain[64];
+        while (read(wake_pipe[0], drain, sizeof(drain)) > 0) {
+        }
+        
+        vector<Completion> finished;
+        {
+            lock_guard<mutex> lock(completed_mutex);
+            finished.swap(completed);
+        }
+        for (Completion& completion : finished) {
+            Session& session = *completion.session;
+            session.busy = false;
+            session.outbound += completion.reply;
+            if (completion.close_after) {
+                session.closing = true;
+                session.pending = queue<string>();
+            }
+            flushOutbound(session);
+            dispatchNext(pool, completion.session);
+        }
+    }
+    
+    // Best effort at shutdown: replies still buffered get one non-blocking write.
+    void flushFinalReplies() {
+        for (Completion& completion : completed) {
+            completion.session->outbound += completion.reply;
+        }
+        completed.clear();
+        for (auto& pair : sessions) {
+            flushOutbound(*pair.second);
+        }
+    }
+    
+    static sockaddr_un socketAddress(const string& path) {
+        sockaddr_un address{};
+        if (path.size() >= sizeof(address.sun_path)) {
+            throw runtime_error("Daemon socket path too long: " + path);
+        }
+        address.sun_family = AF_UNIX;
+        strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+        return address;
+    }
+    
+    void openListener() {
+        sockaddr_un address = socketAddress(socket_path);
+        
+        // A socket file nobody answers on is left over from an unclean exit
+        if (exists(socket_path)) {
+            if (isListening(socket_path)) {
+                throw runtime_error("Another daemon is already listening on " + socket_path);
+            }
+            unlink(socket_path.c_str());
+        }
+        
+        listen_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (listen_fd < 0) {
+            throw runtime_error("Cannot create daemon socket: " + string(strerror(errno)));
+        }
+        if (bind(listen_fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+            listen(listen_fd, SOMAXCONN) != 0) {
+            string reason = strerror(errno);
+            close(listen_fd);
+            listen_fd = -1;
+            throw runtime_error("Cannot listen on " + socket_path + ": " + reason);
+        }
+        chmod(socket_path.c_str(), 0660);
+        fcntl(listen_fd, F_SETFL, fcntl(listen_fd, F_GETFL) | O_NONBLOCK);
+        
+        if (pipe(wake_pipe) != 0) {
+            throw runtime_error("Cannot create daemon wake pipe: " + string(strerror(errno)));
+        }
+        fcntl(wake_pipe[0], F_SETFL, fcntl(wake_pipe[0], F_GETFL) | O_NONBLOCK);
+        fcntl(wake_pipe[1], F_SETFL, fcntl(wake_pipe[1], F_GETFL) | O_NONBLOCK);
+    }
+    
+public:
+    BankingDaemon(BankingSystem& banking_system, ConfigManager& cfg, const string& path)
+        : bank(banking_system), config(cfg), socket_path(path), listen_fd(-1), requests_served(0) {
+        wake_pipe[0] = wake_pipe[1] = -1;
+        openListener();
+    }
+    
+    BankingDaemon(const BankingDaemon&) = delete;
+    BankingDaemon& operator=(const BankingDaemon&) = delete;
+    
+    ~BankingDaemon() {
+        for (auto& pair : sessions) {
+            close(pair.first);
+        }
+        if (listen_fd >= 0) {
+            close(listen_fd);
+            unlink(socket_path.c_str());
+        }
+        signal_wake_fd = -1;
+        for (int fd : wake_pipe) {
+            if (fd >= 0) close(fd);
+        }
+    }
+    
+    // True if a daemon answers on the path. Checked before the bank is loaded
+    // so a second instance never touches the data files.
+    static bool isListening(const string& path) {
+        sockaddr_un address = socketAddress(path);
+        int probe_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (probe_fd < 0) {
+            return false;
+        }
+        bool listening = connect(probe_fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == 0;
+        close(probe_fd);
+        return listening;
+    }
+    
+    static string resolveSocketPath(ConfigManager& cfg) {
+        string configured = cfg.getString("daemon.socket_path", "");
+        return configured.empty() ? cfg.snapshot().data_directory + "/banking.sock" : configured;
+    }
+    
+    // Serves until SIGINT/SIGTERM or stop(). Requests already queued are
+    // answered before the worker pool is joined.
+    void run() {
+        stop_requested.store(false);
+        signal_wake_fd = wake_pipe[1];
+        signal(SIGPIPE, SIG_IGN);
+        signal(SIGINT, handleSignal);
+        signal(SIGTERM, handleSignal);
+        
+        size_t worker_count = ThreadPool::resolveThreadCount(config.getInt("daemon.worker_threads", 0));
+        Logger::getInstance().info("Daemon listening on " + socket_path + " with " + to_string(worker_count) + " workers");
+        auto start_time = chrono::steady_clock::now();
+        {
+            ThreadPool pool(worker_count);
+            vector<pollfd> poll_fds;
             
-        } catch (const BankingException& e) {
-            // AUTOMATIC ROLLBACK ON ANY ERROR
-            auto rollback_data = transaction_manager.rollback();
-            
-            // Restore account balances
-            for (const auto& snapshot : rollback_data) {
-                Account* acc = findAccount(snapshot.account_no);
-                if (acc && snapshot.modified) {
-                    acc->setBalanceInPaise(snapshot.previous_balance_paise);
-                    Logger::getInstance().info("Restored account " + to_string(snapshot.account_no) + 
-                                              " to previous balance: " + 
-                                              MoneyUtils::formatCurrency(snapshot.previous_balance_paise));
+            while (!stop_requested.load()) {
+                poll_fds.clear();
+                poll_fds.push_back({listen_fd, POLLIN, 0});
+                poll_fds.push_back({wake_pipe[0], POLLIN, 0});
+                for (const auto& pair : sessions) {
+                    const Session& session = *pair.second;
+                    short events = 0;
+                    if (!session.closing && session.outbound.size() < MAX_OUTBOUND_BYTES) {
+                        events |= POLLIN;
+                    }
+                    if (!session.outbound.empty()) {
+                        events |= POLLOUT;
+                    }
+                    if (events != 0) {
+                        poll_fds.push_back({pair.first, events, 0});
+                    }
+                }
+                
+                if (poll(poll_fds.data(), poll_fds.size(), -1) < 0) {
+                    if (errno == EINTR) continue;
+                    Logger::getInstance().error("Daemon poll failed: " + string(strerror(errno)));
+                    break;
+                }
+                
+                // Sessions are only closed on this thread, so every fd polled is still open here
+                for (size_t i = 2; i < poll_fds.size(); i++) {
+                    if (poll_fds[i].revents == 0) continue;
+                    auto session_it = sessions.find(poll_fds[i].fd);
+                    if (session_it == sessions.end()) continue;
+                    shared_ptr<Session> session = session_it->second;
+                    // A hang-up while output is buffered surfaces as a failed send
+                    if ((poll_fds[i].revents & (POLLOUT | POLLERR | POLLHUP)) && !session->outbound.empty()) {
+                        writeSession(pool, session);
+                        if (sessions.find(poll_fds[i].fd) == sessions.end()) continue;
+                    }
+                    if ((poll_fds[i].revents & ~POLLOUT) && !session->closing) {
+                        readSession(pool, session);
+                    }
+                }
+                if (poll_fds[1].revents != 0) {
+                    processCompletions(pool);
+                }
+                if (poll_fds[0].revents != 0) {
+                    acceptConnections();
                 }
             }
             
-            cout << "\n❌ Transfer failed and rolled back: " << e.what() << endl;
-            Logger::getInstance().error("Transfer failed and rolled back: " + string(e.what()));
+            close(listen_fd);
+            listen_fd = -1;
+            unlink(socket_path.c_str());
+            
+            for (auto& job : auth_jobs) {
+                job.wait();
+            }
+            auth_jobs.clear();
         }
+        flushFinalReplies();
+        
+        double elapsed = chrono::duration<double>(chrono::steady_clock::now() - start_time).count();
+        Logger::getInstance().info("Daemon stopped after serving " + to_string(requests_served.load()) + 
+                                  " requests in " + to_string(elapsed) + "s");
     }
     
-    void applyMonthlyInterest() {
-        User* current_user = getCurrentUser();
-        if (!current_user || !current_user->isAdmin()) {
-            cout << "❌ Admin access required for this operation!" << endl;
-            return;
+    void stop() {
+        stop_requested.store(true);
+        wake();
+    }
+    
+    long long getRequestsServed() const { return requests_served.load(); }
+};
+
+atomic<bool> BankingDaemon::stop_requested(false);
+int BankingDaemon::signal_wake_fd = -1;
+
+#endif
+
+// =============================================================================
+// CONCURRENT TRANSFER STRESS TEST
+// =============================================================================
+//
+// Runs random transfers between synthetic savings accounts from several
+// threads against an isolated data directory, then checks that the total
+// money held by the bank is unchanged - both in memory and after reloading
+// the persisted state from disk.
+
+class TransferStressTest {
+public:
+    struct Result {
+        long long initial_total_paise;
+        long long final_total_paise;
+        long long reloaded_total_paise;
+        int committed;
+        int rejected;
+        double elapsed_seconds;
+        Durability::Stats durability;
+        
+        Result() : initial_total_paise(0), final_total_paise(0), reloaded_total_paise(0),
+                   committed(0), rejected(0), elapsed_seconds(0.0), durability() {}
+        
+        bool conserved() const {
+            return final_total_paise == initial_total_paise && reloaded_total_paise == initial_total_paise;
         }
+    };
+    
+private:
+    ConfigManager& config;
+    int thread_count;
+    int transfers_per_thread;
+    int account_count;
+    
+    static const int FIRST_ACCOUNT = 500001;
+    static const long long OPENING_BALANCE_PAISE = 1000000;  // Rs. 10,000
+    
+public:
+    TransferStressTest(ConfigManager& cfg, int threads, int transfers, int accounts)
+        : config(cfg), thread_count(max(1, threads)), transfers_per_thread(max(1, transfers)),
+          account_count(max(2, accounts)) {}
+    
+    Result run() {
+        Result result;
         
-        cout << "\n=== 📈 APPLYING MONTHLY INTEREST ===" << endl;
-        int count = 0;
-        long long total_interest_paise = 0;
+        string data_dir = config.getString("directory.data", "data") + "_stress";
+        filesystem::remove_all(data_dir);
+        filesystem::create_directories(data_dir);
+        config.setRuntimeValue("directory.data", data_dir);
         
-        for (auto& pair : accounts) {
-            SavingsAccount* savings_acc = dynamic_cast<SavingsAccount*>(pair.second.get());
-            if (savings_acc) {
-                long long interest_before_paise = savings_acc->calculateInterestInPaise();
-                savings_acc->applyMonthlyInterest();
-                total_interest_paise = MoneyUtils::addMoney(total_interest_paise, interest_before_paise);
-                count++;
+        {
+            BankingSystem bank(&config);
+            for (int i = 0; i < account_count; i++) {
+                auto savings_acc = make_unique<SavingsAccount>();
+                savings_acc->setAccountDetails(FIRST_ACCOUNT + i, "Stress Account " + to_string(i + 1),
+                                               "9000000000", "Synthetic", OPENING_BALANCE_PAISE);
+                bank.addAccount(move(savings_acc));
+            }
+            bank.checkpoint();
+            result.initial_total_paise = bank.getTotalBalanceInPaise();
+            
+            atomic<int> committed(0);
+            atomic<int> rejected(0);
+            Durability::resetStats();
+            auto start_time = chrono::steady_clock::now();
+            
+            vector<thread> workers;
+            for (int t = 0; t < thread_count; t++) {
+                workers.emplace_back([&, t]() {
+                    mt19937 rng(static_cast<unsigned>(t) * 7919u + 17u);
+                    uniform_int_distribution<int> pick_account(0, account_count - 1);
+                    uniform_int_distribution<long long> pick_amount(100, OPENING_BALANCE_PAISE / 2);
+                    
+                    for (int i = 0; i < transfers_per_thread; i++) {
+                        int from_acc = FIRST_ACCOUNT + pick_account(rng);
+                        int to_acc = FIRST_ACCOUNT + pick_account(rng);
+                        if (from_acc == to_acc) {
+                            to_acc = FIRST_ACCOUNT + (to_acc - FIRST_ACCOUNT + 1) % account_count;
+                        }
+                        try {
+                            if (bank.tryTransfer(from_acc, to_acc, pick_amount(rng)).ok()) {
+                                committed.fetch_add(1, memory_order_relaxed);
+                            } else {
+                                rejected.fetch_add(1, memory_order_relaxed);
+                            }
+                        } catch (const exception&) {
+                            rejected.fetch_add(1, memory_order_relaxed);
+                        }
+                    }
+                });
+            }
+            for (auto& worker : workers) {
+                worker.join();
             }
+            
+            result.elapsed_seconds = chrono::duration<double>(chrono::steady_clock::now() - start_time).count();
+            result.durability = Durability::getStats();
+            result.committed = committed.load();
+            result.rejected = rejected.load();
+            result.final_total_paise = bank.getTotalBalanceInPaise();
         }
         
-        cout << "\n📊 Interest applied to " << count << " savings accounts." << endl;
-        cout << "💰 Total interest credited: " << MoneyUtils::formatCurrency(total_interest_paise) << endl;
-        
-        if (count > 0) {
-            saveAllData();
-        }
+        BankingSystem reloaded(&config);
+        result.reloaded_total_paise = reloaded.getTotalBalanceInPaise();
+        return result;
     }
     
-    void manageAccount(int acc_no) {
-        Account* account = findAccount(acc_no);
-        if (!account) {
-            cout << "❌ Account not found!" << endl;
-            return;
-        }
-        
-        if (!canAccessAccount(acc_no)) {
-            cout << "❌ You don't have access to this account!" << endl;
-            return;
-        }
+    void printResult(const Result& result) const {
+        int total = result.committed + result.rejected;
+        
+        cout << "\n=== 🧪 TRANSFER STRESS TEST ===" << endl;
+        cout << "Threads:    " << thread_count << endl;
+        cout << "Accounts:   " << account_count << endl;
+        cout << "Committed:  " << result.committed << endl;
+        cout << "Rejected:   " << result.rejected << endl;
+        cout << "Initial total:  " << MoneyUtils::formatCurrency(result.initial_total_paise) << endl;
+        cout << "Final total:    " << MoneyUtils::formatCurrency(result.final_total_paise) << endl;
+        cout << "Reloaded total: " << MoneyUtils::formatCurrency(result.reloaded_total_paise) << endl;
+        cout << "Elapsed:    " << fixed << setprecision(3) << result.elapsed_seconds << " s" << endl;
+        cout << "Throughput: " << fixed << setprecision(1)
+             << (result.elapsed_seconds > 0 ? total / result.elapsed_seconds : 0.0) << " transfers/sec" << endl;
+        cout << "Durability: " << Durability::modeToString(Durability::getMode()) << ", " 
+             << result.durability.fsyncs << " fsyncs (" << fixed << setprecision(1) 
+             << result.durability.fsyncsPerSecond() << "/sec), commit latency avg " 
+             << result.durability.average_commit_us << " us, max " << result.durability.max_commit_us << " us" << endl;
+        cout << (result.conserved() ? "✅ PASS: total balance conserved" : "❌ FAIL: total balance changed") << endl;
+    }
+};
+
+// =============================================================================
+// BENCHMARK SUITE
+// =============================================================================
+//
+// Microbenchmarks time individual hot functions; macrobenchmarks time whole
+// operations against synthetic datasets generated in an isolated data
+// directory. Results are written as JSON so runs from different versions can
+// be compared mechanically.
+
+class BenchmarkSuite {
+public:
+    struct Measurement {
+        string name;
+        string category;
+        size_t dataset_size;
+        long long iterations;
+        double elapsed_seconds;
+    };
+    
+private:
+    ConfigManager& config;
+    vector<size_t> dataset_sizes;
+    vector<Measurement> measurements;
+    string benchmark_directory;
+    size_t sink;  // consumes benchmarked results so they cannot be optimised away
+    
+    static const int FIRST_ACCOUNT = 100001;
+    static const long long MICRO_ITERATIONS = 200000;
+    static const int TRANSFER_COUNT = 20000;
+    static const long long DECLINE_ITERATIONS = 20000;
+    static const long long KDF_ITERATIONS = 20;
+    
+    template<typename Body>
+    void measure(const string& name, const string& category, size_t dataset_size, long long iterations, Body body) {
+        auto start_time = chrono::steady_clock::now();
+        body();
+        double elapsed_seconds = chrono::duration<double>(chrono::steady_clock::now() - start_time).count();
+        measurements.push_back({name, category, dataset_size, iterations, elapsed_seconds});
         
-        if (!auth_manager.authenticate(acc_no)) {
-            return;
-        }
+        cout << "⏱️ " << left << setw(28) << name << setw(10) << (dataset_size ? to_string(dataset_size) : "-")
+             << fixed << setprecision(1) << (iterations > 0 ? elapsed_seconds * 1e9 / iterations : 0.0) << " ns/op" << endl;
+    }
+    
+    // Deterministic mix of 60% savings, 30% current and 10% loan accounts.
+    static bool isLoanSlot(size_t index) { return index % 10 == 9; }
+    
+    static map<int, unique_ptr<Account>> generateAccounts(size_t count, unsigned seed) {
+        mt19937 rng(seed);
+        uniform_int_distribution<long long> balance_paise(100000, 100000000);
+        uniform_int_distribution<int> rate_tenths(10, 80);
+        time_t created = TimeUtils::getCurrentUTC();
         
-        int op_choice;
-        do {
-            showOperationsMenu();
-            op_choice = InputValidator::getValidChoice("Enter your choice: ", 1, 10);
+        map<int, unique_ptr<Account>> accounts;
+        for (size_t i = 0; i < count; i++) {
+            int acc_no = FIRST_ACCOUNT + static_cast<int>(i);
+            stringstream record;
+            record << acc_no << "|Customer " << acc_no << "|9" << setw(9) << setfill('0') << i << setfill(' ')
+                   << "|Synthetic Address " << (i % 1000) << "|";
             
-            switch (op_choice) {
-                case 1:
-                    account->displayAccountInfo();
-                    break;
-                case 2:
-                    account->processDeposit();
-                    saveAllData();
-                    break;
-                case 3:
-                    account->processWithdrawal();
-                    saveAllData();
-                    break;
-                case 4:
-                    account->showTransactionHistory();
-                    break;
-                case 5:
-                    account->showTransactionHistory(20, TransactionType::DEPOSIT);
-                    break;
-                case 6:
-                    account->showTransactionHistory(20, TransactionType::WITHDRAWAL);
-                    break;
-                case 7:
-                    account->generateAccountStatement();
-                    break;
-                case 8: {
-                    string filename = "statement_" + to_string(acc_no) + "_" + 
-                                     to_string(TimeUtils::getCurrentUTC()) + ".csv";
-                    exportAccountStatement(*account, filename);
-                    break;
-                }
-                case 10:
-                    break;
-                default:
-                    cout << "❌ Invalid choice." << endl;
+            if (isLoanSlot(i)) {
+                long long principal = balance_paise(rng);
+                record << principal << "|LOAN|" << created << "|" << principal << "|9.5|120|0";
+            } else if (i % 10 >= 6) {
+                record << balance_paise(rng) << "|CURRENT|" << created << "|5000000|5000000";
+            } else {
+                record << balance_paise(rng) << "|SAVINGS|" << created << "|" << (rate_tenths(rng) / 10.0);
             }
-        } while (op_choice != 10);
-    }
-    
-    void exportAccountStatement(const Account& account, const string& filename) {
-        ofstream file(filename);
-        if (file.is_open()) {
-            file << "=== ACCOUNT STATEMENT ===" << endl;
-            file << "Account Number: " << account.getAccountNumber() << endl;
-            file << "Name: " << account.getName() << endl;
-            file << "Current Balance: " << MoneyUtils::formatCurrency(account.getBalanceInPaise()) << endl;
-            file << "Account Type: " << accountTypeToString(account.getAccountType()) << endl;
-            file << "Statement Generated: " << TimeUtils::getCurrentTimestampUTC() << endl;
-            file << "\nTransaction History:" << endl;
-            file << "TXN_ID,Type,Amount_Paise,Balance_After_Paise,Timestamp_UTC,Description" << endl;
             
-            for (const auto& trans : account.getTransactionHistory()) {
-                file << trans.getTransactionId() << ","
-                     << transactionTypeToString(trans.getType()) << ","
-                     << trans.getAmountInPaise() << ","
-                     << trans.getBalanceAfterInPaise() << ","
-                     << trans.getTimestamp() << ","
-                     << trans.getDescription() << endl;
+            unique_ptr<Account> account = FileManager::accountFromRecord(record.str());
+            if (account) {
+                accounts[acc_no] = move(account);
             }
-            file.close();
-            cout << "📄 Statement exported to " << filename << endl;
-            Logger::getInstance().info("Statement exported for account " + to_string(account.getAccountNumber()) + 
-                                      " to " + filename);
-        } else {
-            cout << "❌ Error: Could not export statement." << endl;
-            Logger::getInstance().error("Failed to export statement for account " + to_string(account.getAccountNumber()));
         }
+        return accounts;
     }
     
-    void listUserAccounts() {
-        User* current_user = getCurrentUser();
-        if (current_user) {
-            cout << "\n📋 Your Accounts:" << endl;
-            const auto& owned_accounts = current_user->getOwnedAccounts();
-            if (owned_accounts.empty()) {
-                cout << "No accounts found." << endl;
-                return;
-            }
-            
-            cout << left << setw(12) << "Account No" << setw(20) << "Name" 
-                 << setw(12) << "Type" << setw(15) << "Balance" << "Phone" << endl;
-            cout << string(70, '-') << endl;
-            
-            for (int acc_no : owned_accounts) {
-                Account* acc = findAccount(acc_no);
-                if (acc) {
-                    cout << left << setw(12) << acc_no << setw(20) << acc->getName().substr(0, 18)
-                         << setw(12) << accountTypeToString(acc->getAccountType()) 
-                         << setw(15) << MoneyUtils::formatCurrency(acc->getBalanceInPaise())
-                         << acc->getPhoneNumber() << endl;
-                }
+    void resetDataDirectory() {
+        TransactionFileAppender::getInstance().flushAll();
+        filesystem::remove_all(benchmark_directory);
+        filesystem::create_directories(benchmark_directory);
+    }
+    
+    void runMicrobenchmarks() {
+        measure("money.format_currency", "micro", 0, MICRO_ITERATIONS, [this]() {
+            for (long long i = 0; i < MICRO_ITERATIONS; i++) {
+                sink += MoneyUtils::formatCurrency((i * 7919) % 1000000000).size();
             }
-        } else {
-            cout << "\n👤 Guest Mode - Limited Access" << endl;
-            cout << "Please login to view detailed account information." << endl;
-            cout << "Total accounts in system: " << accounts.size() << endl;
+        });
+        
+        vector<Transaction> transactions;
+        vector<string> csv_lines;
+        for (int i = 0; i < 1024; i++) {
+            transactions.emplace_back(static_cast<TransactionType>(i % 4), 1000 + i * 37, 500000 + i * 101,
+                                      "Benchmark transaction " + to_string(i));
+            csv_lines.push_back(transactions.back().toCSV());
         }
+        
+        measure("transaction.to_csv", "micro", 0, MICRO_ITERATIONS, [this, &transactions]() {
+            for (long long i = 0; i < MICRO_ITERATIONS; i++) {
+                sink += transactions[i & 1023].toCSV().size();
+            }
+        });
+        
+        measure("transaction.from_csv", "micro", 0, MICRO_ITERATIONS, [this, &csv_lines]() {
+            for (long long i = 0; i < MICRO_ITERATIONS; i++) {
+                sink += Transaction::fromCSV(csv_lines[i & 1023]).getAmountInPaise();
+            }
+        });
+        
+        pair<string, string> hashed = SecurityManager::hashWithSalt("benchmark-password");
+        measure("security.verify_hash", "micro", 0, KDF_ITERATIONS, [this, &hashed]() {
+            for (long long i = 0; i < KDF_ITERATIONS; i++) {
+                sink += SecurityManager::verifyHash("benchmark-password", hashed.first, hashed.second) ? 1 : 0;
+            }
+        });
+        
+        measure("latency.record", "micro", 0, MICRO_ITERATIONS, []() {
+            for (long long i = 0; i < MICRO_ITERATIONS; i++) {
+                LatencyHistograms::record(LatencyMetric::ACCOUNT_CREDIT, static_cast<uint64_t>(i & 0xFFFFF));
+            }
+        });
+        
+        const string log_message = "Benchmark log record for throughput measurement";
+        measure("logger.log", "micro", 0, MICRO_ITERATIONS, [&log_message]() {
+            Logger& logger = Logger::getInstance();
+            for (long long i = 0; i < MICRO_ITERATIONS; i++) {
+                logger.log(LogLevel::INFO, log_message);
+            }
+        });
     }
     
-    void run() {
-        cout << "🏦 Welcome to Enterprise Banking System v6.0 - Production Ready" << endl;
-        cout << "=================================================================" << endl;
-        cout << "✅ Features: Monetary Precision, UTC Timestamps, Transaction Rollback, Thread Safety" << endl;
-        
-        if (!userLogin()) {
-            cout << "❌ Login failed. Exiting..." << endl;
-            return;
+    void runMacrobenchmarks(size_t dataset_size) {
+        resetDataDirectory();
+        map<int, unique_ptr<Account>> generated = generateAccounts(dataset_size, 42u + static_cast<unsigned>(dataset_size));
+        vector<const Account*> account_list = FileManager::toAccountList(generated);
+        
+        for (const string format : {"binary", "text"}) {
+            config.setRuntimeValue("file.accounts_format", format);
+            measure("file.save_accounts_" + format, "macro", dataset_size, dataset_size, [&account_list]() {
+                FileManager::saveAllAccounts(account_list);
+            });
+            measure("file.load_accounts_" + format, "macro", dataset_size, dataset_size, [this]() {
+                sink += FileManager::loadAccounts().size();
+            });
         }
+        generated.clear();
         
-        int choice;
-        do {
-            showMainMenu();
-            choice = InputValidator::getValidChoice("Enter your choice: ", 0, 15);
-            
-            switch (choice) {
-                case 1:
-                    createAccount(AccountType::SAVINGS);
-                    break;
-                case 2:
-                    createAccount(AccountType::CURRENT);
-                    break;
-                case 3:
-                    createAccount(AccountType::LOAN);
-                    break;
-                case 4: {
-                    int acc_no = InputValidator::getValidAccountNumber("Enter account number to manage: ");
-                    manageAccount(acc_no);
-                    break;
-                }
-                case 5:
-                    transferMoney();
-                    break;
-                case 6:
-                    listUserAccounts();
-                    break;
-                case 7:
-                    exportAllAccountData();
-                    break;
-                case 8:
-                    applyMonthlyInterest();
-                    break;
-                case 9:
-                    adminMenu();
-                    break;
-                case 10:
-                    showSystemStatistics();
-                    break;
-                case 11:
-                    saveAllData();
-                    cout << "💾 All data saved successfully!" << endl;
-                    break;
-                case 0:
-                    cout << "\n🙏 Thank you for banking with us!" << endl;
-                    break;
-                default:
-                    cout << "❌ Invalid choice. Please try again." << endl;
+        BankingSystem bank(&config);
+        size_t thread_count = ThreadPool::resolveThreadCount(0);
+        int transfers_per_thread = max(1, TRANSFER_COUNT / static_cast<int>(thread_count));
+        
+        measure("bank.transfer", "macro", dataset_size, transfers_per_thread * static_cast<long long>(thread_count),
+                [&bank, &thread_count, transfers_per_thread, dataset_size]() {
+            vector<thread> workers;
+            for (size_t t = 0; t < thread_count; t++) {
+                workers.emplace_back([&bank, t, transfers_per_thread, dataset_size]() {
+                    mt19937 rng(static_cast<unsigned>(t) + 1u);
+                    uniform_int_distribution<size_t> pick_index(0, dataset_size - 1);
+                    for (int i = 0; i < transfers_per_thread; i++) {
+                        size_t from_index = pick_index(rng);
+                        size_t to_index = pick_index(rng);
+                        if (isLoanSlot(from_index)) from_index--;
+                        if (isLoanSlot(to_index)) to_index--;
+                        if (from_index == to_index) to_index = (to_index + 1) % dataset_size;
+                        try {
+                            bank.executeTransfer(FIRST_ACCOUNT + static_cast<int>(from_index),
+                                                 FIRST_ACCOUNT + static_cast<int>(to_index), 1000);
+                        } catch (const exception&) {
+                            // Rejections are part of the measured workload.
+                        }
+                    }
+                });
+            }
+            for (auto& worker : workers) {
+                worker.join();
+            }
+        });
+        
+        // Decline path: the same insufficient-funds transfer through the
+        // throwing API and through the status API.
+        Account* drained = bank.findAccount(FIRST_ACCOUNT);
+        drained->setBalanceInPaise(0);
+        drained->publishAggregates();
+        measure("bank.decline_exception", "macro", dataset_size, DECLINE_ITERATIONS, [this, &bank]() {
+            for (long long i = 0; i < DECLINE_ITERATIONS; i++) {
+                try {
+                    bank.executeTransfer(FIRST_ACCOUNT, FIRST_ACCOUNT + 1, 1000);
+                } catch (const InsufficientFundsException&) {
+                    sink++;
+                }
             }
-        } while (choice != 0);
+        });
+        measure("bank.decline_status", "macro", dataset_size, DECLINE_ITERATIONS, [this, &bank]() {
+            for (long long i = 0; i < DECLINE_ITERATIONS; i++) {
+                sink += bank.tryTransfer(FIRST_ACCOUNT, FIRST_ACCOUNT + 1, 1000).ok() ? 0 : 1;
+            }
+        });
+        
+        InterestEngine::Result interest;
+        measure("bank.monthly_interest", "macro", dataset_size, (dataset_size * 6 + 9) / 10, [&bank, &interest]() {
+            interest = bank.runMonthEndInterest();
+        });
+        sink += interest.accounts_credited;
     }
     
-private:
-    void showMainMenu() {
-        User* current_user = getCurrentUser();
+    void writeJson(ostream& out) const {
+        out << "{\n";
+        out << "  \"suite\": \"enterprise-banking-v6\",\n";
+        out << "  \"timestamp_utc\": \"" << TimeUtils::getCurrentTimestampUTC() << "\",\n";
+        out << "  \"hardware_threads\": " << thread::hardware_concurrency() << ",\n";
+        out << "  \"results\": [\n";
+        for (size_t i = 0; i < measurements.size(); i++) {
+            const Measurement& m = measurements[i];
+            double ns_per_op = m.iterations > 0 ? m.elapsed_seconds * 1e9 / m.iterations : 0.0;
+            double ops_per_sec = m.elapsed_seconds > 0 ? m.iterations / m.elapsed_seconds : 0.0;
+            out << "    {\"name\": \"" << m.name << "\", \"category\": \"" << m.category << "\", "
+                << "\"dataset_size\": " << m.dataset_size << ", \"iterations\": " << m.iterations << ", "
+                << fixed << setprecision(6) << "\"elapsed_seconds\": " << m.elapsed_seconds << ", "
+                << setprecision(2) << "\"ns_per_op\": " << ns_per_op << ", \"ops_per_sec\": " << ops_per_sec << "}"
+                << (i + 1 < measurements.size() ? "," : "") << "\n";
+        }
+        out << "  ]\n";
+        out << "}\n";
+    }
+    
+public:
+    BenchmarkSuite(ConfigManager& cfg, const vector<size_t>& sizes)
+        : config(cfg), dataset_sizes(sizes), sink(0) {
+        benchmark_directory = config.getString("directory.data", "data") + "_benchmark";
+    }
+    
+    // 1,000,000 accounts take minutes and several GB, so that size is only
+    // run when listed explicitly.
+    static constexpr const char* DEFAULT_DATASET_SIZES = "10000,100000";
+    
+    static vector<size_t> parseDatasetSizes(const string& list) {
+        vector<size_t> sizes;
+        stringstream ss(list);
+        string item;
+        while (getline(ss, item, ',')) {
+            if (!item.empty() && stoll(item) > 1) {
+                sizes.push_back(static_cast<size_t>(stoll(item)));
+            }
+        }
+        return sizes;
+    }
+    
+    bool run(const string& output_file) {
+        string original_directory = config.getString("directory.data", "data");
+        string original_format = config.getString("file.accounts_format", "text");
+        config.setRuntimeValue("directory.data", benchmark_directory);
+        
+        cout << "\n=== 🏁 BENCHMARK SUITE ===" << endl;
+        runMicrobenchmarks();
+        for (size_t dataset_size : dataset_sizes) {
+            runMacrobenchmarks(dataset_size);
+        }
         
-        cout << "\n=== 🏦 MAIN MENU ===" << endl;
-        cout << "1. Create Savings Account" << endl;
-        cout << "2. Create Current Account" << endl;
-        cout << "3. Create Loan Account" << endl;
-        cout << "4. Manage Account" << endl;
-        cout << "5. Transfer Money (2FA Required)" << endl;
-        cout << "6. List " << (current_user ? "My" : "All") << " Accounts" << endl;
-        cout << "7. Export Account Data" << endl;
-        cout << "8. Apply Monthly Interest" << (current_user && current_user->isAdmin() ? "" : " (Admin Only)") << endl;
-        cout << "9. Admin Menu" << (current_user && current_user->isAdmin() ? "" : " (Admin Only)") << endl;
-        cout << "10. System Statistics" << endl;
-        cout << "11. Save All Data" << endl;
-        cout << "0. Exit" << endl;
+        TransactionFileAppender::getInstance().flushAll();
+        filesystem::remove_all(benchmark_directory);
+        config.setRuntimeValue("directory.data", original_directory);
+        config.setRuntimeValue("file.accounts_format", original_format);
         
-        if (current_user) {
-            cout << "\n👤 Logged in as: " << current_user->getUsername() 
-                 << " [" << (current_user->isAdmin() ? "ADMIN" : "USER") << "]" << endl;
-        } else {
-            cout << "\n👤 Mode: Guest (Limited Access)" << endl;
+        ofstream out(output_file);
+        if (!out.is_open()) {
+            cout << "❌ Cannot write benchmark results to " << output_file << endl;
+            return false;
         }
+        writeJson(out);
+        cout << "📄 Results written to " << output_file << " (checksum " << sink << ")" << endl;
+        return true;
     }
+};
+
+// =============================================================================
+// WORKLOAD GENERATOR AND LATENCY REPORTER
+// =============================================================================
+//
+// Creates the same synthetic bank on every run (N accounts of each type, fixed
+// seed) in an isolated data directory and drives a configurable mix of
+// deposits, withdrawals, transfers and EMI payments through the thread-safe
+// try* API. Account choice is uniform or Zipfian. With a target rate the load
+// is open-loop: each operation has an intended start time and its latency is
+// measured from that time, so queueing behind a slow operation is counted
+// instead of hidden. Without one, every thread issues back to back.
+
+// Zipfian ranks 0..n-1 (rank 0 hottest), after Gray et al.'s
+// "Quickly Generating Billion-Record Synthetic Databases".
+class ZipfianDistribution {
+private:
+    size_t item_count;
+    double theta;
+    double zeta_n;
+    double alpha;
+    double eta;
+    uniform_real_distribution<double> uniform;
     
-    void showOperationsMenu() {
-        cout << "\n--- 💳 Account Operations ---" << endl;
-        cout << "1. Display Account Details" << endl;
-        cout << "2. Deposit Money" << endl;
-        cout << "3. Withdraw Money" << endl;
-        cout << "4. View Transaction History" << endl;
-        cout << "5. View Deposits Only" << endl;
-        cout << "6. View Withdrawals Only" << endl;
-        cout << "7. Generate Account Statement" << endl;
-        cout << "8. Export Statement to File" << endl;
-        cout << "10. Back to Main Menu" << endl;
+    static double zeta(size_t n, double theta_value) {
+        double sum = 0.0;
+        for (size_t i = 1; i <= n; i++) {
+            sum += 1.0 / pow(static_cast<double>(i), theta_value);
+        }
+        return sum;
     }
     
-    void exportAllAccountData() {
-        User* current_user = getCurrentUser();
-        if (!current_user) {
-            cout << "❌ Please login to export data." << endl;
-            return;
+public:
+    ZipfianDistribution(size_t n, double skew) 
+        : item_count(max<size_t>(1, n)), theta(skew), uniform(0.0, 1.0) {
+        if (theta <= 0.0 || theta >= 1.0) {
+            throw invalid_argument("Zipfian theta must be between 0 and 1 (exclusive)");
         }
-        
-        const auto& owned_accounts = current_user->getOwnedAccounts();
-        if (owned_accounts.empty()) {
-            cout << "No accounts to export." << endl;
-            return;
+        zeta_n = zeta(item_count, theta);
+        alpha = 1.0 / (1.0 - theta);
+        eta = (1.0 - pow(2.0 / item_count, 1.0 - theta)) / (1.0 - zeta(2, theta) / zeta_n);
+    }
+    
+    template<typename Generator>
+    size_t operator()(Generator& rng) {
+        double u = uniform(rng);
+        double uz = u * zeta_n;
+        if (uz < 1.0) return 0;
+        if (uz < 1.0 + pow(0.5, theta)) return min<size_t>(1, item_count - 1);
+        return min(item_count - 1, static_cast<size_t>(item_count * pow(eta * u - eta + 1.0, alpha)));
+    }
+};
+
+class LoadGenerator {
+public:
+    enum Operation { DEPOSIT = 0, WITHDRAW, TRANSFER, EMI, OPERATION_COUNT };
+    
+    struct Options {
+        int accounts_per_type = 1000;
+        long long operations = 200000;
+        int threads = 0;                             // 0 = one per hardware core
+        array<int, OPERATION_COUNT> mix = {{40, 30, 25, 5}};
+        bool zipfian = false;
+        double zipf_theta = 0.99;
+        double target_rate = 0.0;                    // ops/sec across all threads; 0 = closed loop
+        unsigned seed = 42;
+        string report_file;
+    };
+    
+    struct OperationReport {
+        long long completed = 0;
+        long long declined = 0;
+        long long p50_ns = 0;
+        long long p99_ns = 0;
+        long long p999_ns = 0;
+        long long max_ns = 0;
+    };
+    
+    struct Report {
+        array<OperationReport, OPERATION_COUNT> operations;
+        OperationReport overall;
+        double elapsed_seconds = 0.0;
+        size_t thread_count = 0;
+    };
+    
+private:
+    ConfigManager& config;
+    Options options;
+    size_t thread_count;
+    
+    static const int FIRST_ACCOUNT = 700001;
+    static const long long OPENING_BALANCE_PAISE = 10000000;  // Rs. 1,00,000
+    static const long long LOAN_PRINCIPAL_PAISE = 50000000;   // Rs. 5,00,000
+    
+    struct ThreadSamples {
+        array<vector<long long>, OPERATION_COUNT> latencies_ns;
+        array<long long, OPERATION_COUNT> declined{};
+    };
+    
+    static const char* operationName(int operation) {
+        static const char* names[OPERATION_COUNT] = {"deposit", "withdraw", "transfer", "emi"};
+        return names[operation];
+    }
+    
+    // Accounts FIRST_ACCOUNT.. are savings, then current, then loan.
+    void createAccounts(BankingSystem& bank) const {
+        int n = options.accounts_per_type;
+        for (int i = 0; i < n; i++) {
+            auto savings_acc = make_unique<SavingsAccount>();
+            savings_acc->setAccountDetails(FIRST_ACCOUNT + i, "Load Savings " + to_string(i + 1),
+                                           "9000000000", "Synthetic", OPENING_BALANCE_PAISE);
+            savings_acc->setInterestRate(4.0f);
+            bank.addAccount(move(savings_acc));
+            
+            auto current_acc = make_unique<CurrentAccount>();
+            current_acc->setAccountDetails(FIRST_ACCOUNT + n + i, "Load Current " + to_string(i + 1),
+                                           "9000000000", "Synthetic", OPENING_BALANCE_PAISE);
+            current_acc->setOverdraftDetails(OPENING_BALANCE_PAISE / 2, OPENING_BALANCE_PAISE / 2);
+            bank.addAccount(move(current_acc));
+            
+            auto loan_acc = make_unique<LoanAccount>();
+            loan_acc->setAccountDetails(FIRST_ACCOUNT + 2 * n + i, "Load Loan " + to_string(i + 1),
+                                        "9000000000", "Synthetic", LOAN_PRINCIPAL_PAISE);
+            loan_acc->setLoanDetails(LOAN_PRINCIPAL_PAISE, 9.5f, 120, 0);
+            bank.addAccount(move(loan_acc));
+        }
+        bank.checkpoint();
+    }
+    
+    // Deposit, withdraw and transfer target savings and current accounts;
+    // EMI payments target loans. Rank 0 is the hottest account of each pool.
+    class AccountPicker {
+    private:
+        int pool_size;
+        bool zipfian;
+        uniform_int_distribution<int> uniform;
+        unique_ptr<ZipfianDistribution> zipf;
+        
+    public:
+        AccountPicker(int size, const Options& opts)
+            : pool_size(max(1, size)), zipfian(opts.zipfian), uniform(0, max(1, size) - 1) {
+            if (zipfian) {
+                zipf = make_unique<ZipfianDistribution>(static_cast<size_t>(pool_size), opts.zipf_theta);
+            }
         }
         
-        string timestamp = to_string(TimeUtils::getCurrentUTC());
-        for (int acc_no : owned_accounts) {
-            Account* acc = findAccount(acc_no);
-            if (acc) {
-                string filename = "statement_" + accountTypeToString(acc->getAccountType()) + "_" + 
-                                 to_string(acc_no) + "_" + timestamp + ".csv";
-                exportAccountStatement(*acc, filename);
+        int operator()(mt19937_64& rng) {
+            return zipfian ? static_cast<int>((*zipf)(rng)) : uniform(rng);
+        }
+    };
+    
+    bool execute(BankingSystem& bank, int operation, mt19937_64& rng, AccountPicker& deposit_pool, 
+                 AccountPicker& loan_pool) const {
+        int n = options.accounts_per_type;
+        uniform_int_distribution<long long> pick_amount(100, 500000);
+        long long amount_paise = pick_amount(rng);
+        
+        switch (operation) {
+            case DEPOSIT:
+            case WITHDRAW: {
+                int acc_no = FIRST_ACCOUNT + deposit_pool(rng);
+                return bank.tryAccountOperation(acc_no, [operation, amount_paise](Account& account) {
+                    return TxnResult(operation == DEPOSIT ? account.tryDeposit(amount_paise) 
+                                                          : account.tryWithdraw(amount_paise), amount_paise);
+                }).ok();
+            }
+            case TRANSFER: {
+                int from_rank = deposit_pool(rng);
+                int to_rank = deposit_pool(rng);
+                if (from_rank == to_rank) {
+                    to_rank = (to_rank + 1) % (2 * n);
+                }
+                return bank.tryTransfer(FIRST_ACCOUNT + from_rank, FIRST_ACCOUNT + to_rank, amount_paise).ok();
+            }
+            default: {
+                int acc_no = FIRST_ACCOUNT + 2 * n + loan_pool(rng);
+                return bank.tryAccountOperation(acc_no, [](Account& account) {
+                    LoanAccount* loan_acc = dynamic_cast<LoanAccount*>(&account);
+                    if (!loan_acc) {
+                        return TxnResult(TxnStatus::NOT_PERMITTED);
+                    }
+                    return loan_acc->tryMakePayment(loan_acc->getEMIAmountInPaise());
+                }).ok();
             }
         }
-        cout << "📄 Export completed for " << owned_accounts.size() << " accounts." << endl;
     }
     
-    void adminMenu() {
-        User* current_user = getCurrentUser();
-        if (!current_user || !current_user->isAdmin()) {
-            cout << "❌ Admin access required!" << endl;
-            return;
+    void worker(BankingSystem& bank, size_t thread_index, long long operation_count, 
+                chrono::steady_clock::time_point start_time, ThreadSamples& samples) const {
+        mt19937_64 rng(options.seed * 1000003ULL + thread_index);
+        AccountPicker deposit_pool(2 * options.accounts_per_type, options);
+        AccountPicker loan_pool(options.accounts_per_type, options);
+        discrete_distribution<int> pick_operation(options.mix.begin(), options.mix.end());
+        
+        for (auto& latencies : samples.latencies_ns) {
+            latencies.reserve(static_cast<size_t>(operation_count));
         }
         
-        cout << "\n=== 👑 ADMIN MENU ===" << endl;
-        cout << "1. Unlock Account" << endl;
-        cout << "2. Apply Monthly Interest to All Savings" << endl;
-        cout << "3. View All Accounts in System" << endl;
-        cout << "4. Create Admin User" << endl;
-        cout << "5. System Configuration" << endl;
-        cout << "9. Back to Main Menu" << endl;
-        
-        int choice = InputValidator::getValidChoice("Enter admin choice: ", 1, 9);
-        
-        switch (choice) {
-            case 1: {
-                int acc_no = InputValidator::getValidAccountNumber("Enter account number to unlock: ");
-                auth_manager.unlockAccount(acc_no);
-                break;
+        // Each thread carries an equal share of the target rate
+        bool open_loop = options.target_rate > 0.0;
+        chrono::steady_clock::duration interval = chrono::duration_cast<chrono::steady_clock::duration>(
+            chrono::duration<double>(open_loop ? thread_count / options.target_rate : 0.0));
+        
+        for (long long i = 0; i < operation_count; i++) {
+            int operation = pick_operation(rng);
+            chrono::steady_clock::time_point intended_start = chrono::steady_clock::now();
+            if (open_loop) {
+                intended_start = start_time + interval * i;
+                this_thread::sleep_until(intended_start);
             }
-            case 2:
-                applyMonthlyInterest();
-                break;
-            case 3: {
-                string saved_username = current_username;
-                
-                cout << "\n=== 📊 ALL SYSTEM ACCOUNTS ===" << endl;
-                cout << left << setw(12) << "Account No" << setw(20) << "Name" 
-                     << setw(12) << "Type" << setw(15) << "Balance" << "Phone" << endl;
-                cout << string(70, '-') << endl;
-                
-                for (const auto& pair : accounts) {
-                    const Account* acc = pair.second.get();
-                    cout << left << setw(12) << pair.first << setw(20) << acc->getName().substr(0, 18)
-                         << setw(12) << accountTypeToString(acc->getAccountType()) 
-                         << setw(15) << MoneyUtils::formatCurrency(acc->getBalanceInPaise())
-                         << acc->getPhoneNumber() << endl;
-                }
-                
-                current_username = saved_username;
-                break;
+            
+            bool applied = false;
+            try {
+                applied = execute(bank, operation, rng, deposit_pool, loan_pool);
+            } catch (const exception&) {
+                applied = false;
             }
-            case 4: {
-                string username = InputValidator::getValidString("Enter new admin username: ");
-                if (users.find(username) != users.end()) {
-                    cout << "❌ Username already exists!" << endl;
-                } else {
-                    string password = InputValidator::getValidString("Enter admin password: ");
-                    User new_admin(username, password, UserRole::ADMIN);
-                    users[username] = new_admin;
-                    saveAllData();
-                    cout << "✅ Admin user created successfully!" << endl;
-                }
-                break;
+            
+            long long latency_ns = chrono::duration_cast<chrono::nanoseconds>(
+                chrono::steady_clock::now() - intended_start).count();
+            samples.latencies_ns[operation].push_back(latency_ns);
+            if (!applied) {
+                samples.declined[operation]++;
             }
-            case 5:
-                cout << "⚙️ Configuration management interface would be implemented here." << endl;
-                cout << "Current config file: " << config->getString("config_file", "config/banking.ini") << endl;
-                break;
-            case 9:
-                break;
         }
     }
     
-    void showSystemStatistics() {
-        cout << "\n=== 📊 SYSTEM STATISTICS ===" << endl;
-        
-        int admin_count = 0, user_count = 0;
-        for (const auto& pair : users) {
-            if (pair.second.isAdmin()) {
-                admin_count++;
-            } else {
-                user_count++;
+    static void summarize(vector<long long>& latencies, long long declined, OperationReport& report) {
+        report.completed = static_cast<long long>(latencies.size());
+        report.declined = declined;
+        if (latencies.empty()) return;
+        
+        sort(latencies.begin(), latencies.end());
+        auto percentile = [&latencies](double fraction) {
+            size_t index = static_cast<size_t>(ceil(fraction * latencies.size()));
+            return latencies[min(latencies.size() - 1, index > 0 ? index - 1 : 0)];
+        };
+        report.p50_ns = percentile(0.50);
+        report.p99_ns = percentile(0.99);
+        report.p999_ns = percentile(0.999);
+        report.max_ns = latencies.back();
+    }
+    
+public:
+    LoadGenerator(ConfigManager& cfg, const Options& opts) : config(cfg), options(opts), thread_count(1) {}
+    
+    // Parses key=value arguments: accounts, ops, threads, mix (deposit:withdraw:
+    // transfer:emi weights), skew (uniform|zipf), theta, rate, seed, report.
+    static Options parseOptions(int argc, char* argv[], int first) {
+        Options opts;
+        for (int i = first; i < argc; i++) {
+            string argument = argv[i];
+            size_t equals = argument.find('=');
+            if (equals == string::npos) {
+                throw invalid_argument("expected key=value, got '" + argument + "'");
             }
+            string key = argument.substr(0, equals);
+            string value = argument.substr(equals + 1);
+            
+            if (key == "accounts") opts.accounts_per_type = max(1, stoi(value));
+            else if (key == "ops") opts.operations = max(1LL, stoll(value));
+            else if (key == "threads") opts.threads = stoi(value);
+            else if (key == "skew") {
+                if (value != "uniform" && value != "zipf") throw invalid_argument("skew must be uniform or zipf");
+                opts.zipfian = (value == "zipf");
+            }
+            else if (key == "theta") opts.zipf_theta = stod(value);
+            else if (key == "rate") opts.target_rate = max(0.0, stod(value));
+            else if (key == "seed") opts.seed = static_cast<unsigned>(stoul(value));
+            else if (key == "report") opts.report_file = value;
+            else if (key == "mix") {
+                stringstream ss(value);
+                string weight;
+                int total = 0;
+                for (int op = 0; op < OPERATION_COUNT; op++) {
+                    if (!getline(ss, weight, ':')) throw invalid_argument("mix needs four weights, e.g. 40:30:25:5");
+                    opts.mix[op] = max(0, stoi(weight));
+                    total += opts.mix[op];
+                }
+                if (total == 0) throw invalid_argument("mix weights must not all be zero");
+            }
+            else throw invalid_argument("unknown option '" + key + "'");
         }
+        if (opts.zipfian && (opts.zipf_theta <= 0.0 || opts.zipf_theta >= 1.0)) {
+            throw invalid_argument("theta must be between 0 and 1 (exclusive)");
+        }
+        return opts;
+    }
+    
+    Report run() {
+        Report report;
         
-        cout << "👥 Users: " << users.size() << " (Admins: " << admin_count 
-             << ", Regular: " << user_count << ")" << endl;
+        string data_dir = config.getString("directory.data", "data") + "_loadgen";
+        filesystem::remove_all(data_dir);
+        filesystem::create_directories(data_dir);
+        config.setRuntimeValue("directory.data", data_dir);
         
-        int savings_count = 0, current_count = 0, loan_count = 0;
-        long long total_balance_paise = 0, total_loans_paise = 0;
+        thread_count = ThreadPool::resolveThreadCount(options.threads);
+        report.thread_count = thread_count;
+        vector<ThreadSamples> samples(thread_count);
         
-        for (const auto& pair : accounts) {
-            const Account* acc = pair.second.get();
+        {
+            BankingSystem bank(&config);
+            createAccounts(bank);
+            Durability::resetStats();
             
-            if (acc->getAccountType() == AccountType::SAVINGS) {
-                savings_count++;
-                total_balance_paise = MoneyUtils::addMoney(total_balance_paise, acc->getBalanceInPaise());
-            } else if (acc->getAccountType() == AccountType::CURRENT) {
-                current_count++;
-                total_balance_paise = MoneyUtils::addMoney(total_balance_paise, acc->getBalanceInPaise());
-            } else if (acc->getAccountType() == AccountType::LOAN) {
-                loan_count++;
-                total_loans_paise = MoneyUtils::addMoney(total_loans_paise, acc->getBalanceInPaise());
+            auto start_time = chrono::steady_clock::now();
+            vector<thread> workers;
+            for (size_t t = 0; t < report.thread_count; t++) {
+                long long share = options.operations / static_cast<long long>(report.thread_count) +
+                                  (static_cast<long long>(t) < options.operations % static_cast<long long>(report.thread_count) ? 1 : 0);
+                workers.emplace_back([this, &bank, &samples, t, share, start_time]() {
+                    worker(bank, t, share, start_time, samples[t]);
+                });
+            }
+            for (auto& worker_thread : workers) {
+                worker_thread.join();
             }
+            report.elapsed_seconds = chrono::duration<double>(chrono::steady_clock::now() - start_time).count();
         }
         
-        cout << "\n💳 Accounts:" << endl;
-        cout << "  Savings: " << savings_count << endl;
-        cout << "  Current: " << current_count << endl;
-        cout << "  Loan: " << loan_count << endl;
-        cout << "  Total: " << accounts.size() << endl;
-        
-        cout << "\n💰 Financial Overview:" << endl;
-        cout << "  Total Deposits: " << MoneyUtils::formatCurrency(total_balance_paise) << endl;
-        cout << "  Outstanding Loans: " << MoneyUtils::formatCurrency(total_loans_paise) << endl;
+        vector<long long> all_latencies;
+        long long all_declined = 0;
+        for (int op = 0; op < OPERATION_COUNT; op++) {
+            vector<long long> merged;
+            long long declined = 0;
+            for (ThreadSamples& thread_samples : samples) {
+                merged.insert(merged.end(), thread_samples.latencies_ns[op].begin(), thread_samples.latencies_ns[op].end());
+                declined += thread_samples.declined[op];
+                vector<long long>().swap(thread_samples.latencies_ns[op]);
+            }
+            all_latencies.insert(all_latencies.end(), merged.begin(), merged.end());
+            all_declined += declined;
+            summarize(merged, declined, report.operations[op]);
+        }
+        summarize(all_latencies, all_declined, report.overall);
+        return report;
+    }
+    
+    void printReport(const Report& report) const {
+        cout << "\n=== 📈 LOAD GENERATOR REPORT ===" << endl;
+        cout << "Accounts:   " << options.accounts_per_type << " per type" << endl;
+        cout << "Threads:    " << report.thread_count << endl;
+        cout << "Skew:       " << (options.zipfian ? "zipf (theta " + to_string(options.zipf_theta) + ")" : string("uniform")) << endl;
+        cout << "Mode:       " << (options.target_rate > 0 ? "open loop at " + to_string(static_cast<long long>(options.target_rate)) + " ops/sec" 
+                                                          : string("closed loop")) << endl;
+        cout << "Seed:       " << options.seed << endl;
+        
+        cout << "\n" << left << setw(10) << "Operation" << right << setw(10) << "Ops" << setw(10) << "Declined"
+             << setw(12) << "p50 us" << setw(12) << "p99 us" << setw(12) << "p99.9 us" << setw(12) << "max us" << endl;
+        cout << string(78, '-') << endl;
+        auto print_row = [](const string& name, const OperationReport& row) {
+            cout << left << setw(10) << name << right << setw(10) << row.completed << setw(10) << row.declined
+                 << fixed << setprecision(1) << setw(12) << row.p50_ns / 1000.0 << setw(12) << row.p99_ns / 1000.0
+                 << setw(12) << row.p999_ns / 1000.0 << setw(12) << row.max_ns / 1000.0 << endl;
+        };
+        for (int op = 0; op < OPERATION_COUNT; op++) {
+            if (report.operations[op].completed > 0) {
+                print_row(operationName(op), report.operations[op]);
+            }
+        }
+        cout << string(78, '-') << endl;
+        print_row("all", report.overall);
         
-        int total_transactions = 0;
-        for (const auto& pair : accounts) {
-            total_transactions += pair.second->getTransactionHistory().size();
+        cout << "\nElapsed:    " << fixed << setprecision(3) << report.elapsed_seconds << " s" << endl;
+        cout << "Throughput: " << fixed << setprecision(1)
+             << (report.elapsed_seconds > 0 ? report.overall.completed / report.elapsed_seconds : 0.0) << " ops/sec" << endl;
+        cout << "Durability: " << Durability::modeToString(Durability::getMode()) << ", " 
+             << Durability::getStats().fsyncs << " fsyncs" << endl;
+    }
+    
+    bool writeReport(const Report& report) const {
+        if (options.report_file.empty()) {
+            return true;
+        }
+        ofstream out(options.report_file);
+        if (!out.is_open()) {
+            cout << "❌ Cannot write load report to " << options.report_file << endl;
+            return false;
         }
-        cout << "\n📈 Transaction Activity:" << endl;
-        cout << "  Total Transactions: " << total_transactions << endl;
-        cout << "  Average per Account: " << fixed << setprecision(1) 
-             << (accounts.empty() ? 0 : (float)total_transactions / accounts.size()) << endl;
         
-        cout << "\n🖥️ System Health:" << endl;
-        cout << "  Next Account Number: " << AccountManager::getNextAccountNumber() + 1 << endl;
-        cout << "  Configuration Status: ✅ Active" << endl;
-        cout << "  Logging Status: ✅ Active (UTC)" << endl;
-        cout << "  Transaction Manager: ✅ Ready" << endl;
+        auto write_row = [&out](const string& name, const OperationReport& row, bool last) {
+            out << "    {\"operation\": \"" << name << "\", \"ops\": " << row.completed << ", \"declined\": " << row.declined
+                << ", \"p50_ns\": " << row.p50_ns << ", \"p99_ns\": " << row.p99_ns << ", \"p999_ns\": " << row.p999_ns
+                << ", \"max_ns\": " << row.max_ns << "}" << (last ? "" : ",") << "\n";
+        };
+        
+        out << "{\n";
+        out << "  \"tool\": \"loadgen\",\n";
+        out << "  \"timestamp_utc\": \"" << TimeUtils::getCurrentTimestampUTC() << "\",\n";
+        out << "  \"accounts_per_type\": " << options.accounts_per_type << ",\n";
+        out << "  \"threads\": " << report.thread_count << ",\n";
+        out << "  \"mix\": [" << options.mix[DEPOSIT] << ", " << options.mix[WITHDRAW] << ", " 
+            << options.mix[TRANSFER] << ", " << options.mix[EMI] << "],\n";
+        out << "  \"skew\": \"" << (options.zipfian ? "zipf" : "uniform") << "\",\n";
+        out << "  \"zipf_theta\": " << options.zipf_theta << ",\n";
+        out << "  \"target_rate\": " << options.target_rate << ",\n";
+        out << "  \"seed\": " << options.seed << ",\n";
+        out << "  \"durability_mode\": \"" << Durability::modeToString(Durability::getMode()) << "\",\n";
+        out << fixed << setprecision(6) << "  \"elapsed_seconds\": " << report.elapsed_seconds << ",\n";
+        out << setprecision(1) << "  \"ops_per_sec\": " 
+            << (report.elapsed_seconds > 0 ? report.overall.completed / report.elapsed_seconds : 0.0) << ",\n";
+        out << "  \"results\": [\n";
+        for (int op = 0; op < OPERATION_COUNT; op++) {
+            write_row(operationName(op), report.operations[op], false);
+        }
+        write_row("all", report.overall, true);
+        out << "  ]\n";
+        out << "}\n";
+        cout << "📄 Report written to " << options.report_file << endl;
+        return true;
     }
 };
 
@@ -2591,7 +9577,7 @@ private:
 // MAIN FUNCTION WITH ALL PRODUCTION FIXES APPLIED
 // =============================================================================
 
-int main() {
+int main(int argc, char* argv[]) {
     try {
         cout << "🚀 Initializing Enterprise Banking System v6.0 - Production Ready..." << endl;
         cout << "✅ Monetary Precision: Integer-based paise arithmetic" << endl;
@@ -2609,15 +9595,153 @@ int main() {
         AccountManager::setConfig(&config);
         AuthenticationManager::setConfig(&config);
         FileManager::setConfig(&config);
+        WriteAheadLog::setConfig(&config);
+        Durability::setConfig(&config);
+        TransactionFileAppender::setConfig(&config);
+        TransactionIdGenerator::setConfig(&config);
+        TransactionIdIndex::setConfig(&config);
+        TransactionTimeIndex::setConfig(&config);
+        
+        LatencyHistograms::setEnabled(config.getInt("metrics.latency_histograms", 1) != 0);
         
         // Set logging level
         Logger& logger = Logger::getInstance();
         logger.setLevel(LogLevel::INFO);
+        if (config.getInt("logging.async", 1) != 0) {
+            logger.startAsync(config.getInt("logging.queue_capacity", 8192),
+                              Logger::parseOverflowPolicy(config.getString("logging.overflow_policy", "drop_debug")));
+        }
         logger.info("Enterprise Banking System v6.0 - Production Ready starting up...");
+        for (const auto& warning : config.snapshot().warnings) {
+            logger.warning("Configuration: " + warning);
+        }
+        
+        // Offline maintenance tools: --convert-to-binary / --convert-to-text [source] [destination]
+        string mode = (argc > 1) ? argv[1] : "";
+        if (mode == "--convert-to-binary" || mode == "--convert-to-text") {
+            string data_dir = config.getString("directory.data", "data");
+            string text_file = data_dir + "/accounts.dat";
+            string binary_file = data_dir + "/accounts.bin";
+            bool to_binary = (mode == "--convert-to-binary");
+            string source = (argc > 2) ? argv[2] : (to_binary ? text_file : binary_file);
+            string destination = (argc > 3) ? argv[3] : (to_binary ? binary_file : text_file);
+            
+            bool converted = to_binary ? FileManager::convertTextToBinary(source, destination)
+                                       : FileManager::convertBinaryToText(source, destination);
+            cout << (converted ? "✅ Converted " : "❌ Conversion failed: ") << source << " -> " << destination << endl;
+            return converted ? 0 : 1;
+        }
+        
+        // Index maintenance: --rebuild-txn-index (ID index and per-account time indexes)
+        if (mode == "--rebuild-txn-index") {
+            size_t entries = TransactionIdIndex::getInstance().rebuild();
+            cout << "✅ Transaction index rebuilt with " << entries << " entries" << endl;
+            
+            size_t time_entries = 0;
+            vector<int> account_numbers = TransactionFileAppender::listAccountFiles(config.getString("directory.data", "data"));
+            for (int account_no : account_numbers) {
+                time_entries += TransactionTimeIndex::getInstance().rebuild(account_no);
+            }
+            cout << "✅ Time indexes rebuilt for " << account_numbers.size() << " accounts (" 
+                 << time_entries << " entries)" << endl;
+            return 0;
+        }
+        
+        ConfigWatcher config_watcher(config);
+        if (config.getInt("config.hot_reload", 1) != 0) {
+            config_watcher.start();
+        }
+        
+        MetricsExporter metrics_exporter(config);
+        metrics_exporter.start();
+        
+        // Startup profiling: --startup-report
+        if (mode == "--startup-report") {
+            logger.setConsoleOutput(false);
+            BankingSystem bank(&config);
+            bank.printStartupReport();
+            return 0;
+        }
+        
+        // Headless batch processing: --batch <command file>
+        if (mode == "--batch") {
+            if (argc < 3) {
+                cout << "Usage: " << argv[0] << " --batch <command file>" << endl;
+                return 1;
+            }
+            logger.setConsoleOutput(false);
+            
+            BankingSystem bank(&config);
+            BatchProcessor processor(bank);
+            BatchProcessor::printSummary(processor.run(argv[2]));
+            return 0;
+        }
+        
+        // Shared local service: --daemon [socket path]
+        if (mode == "--daemon") {
+#ifdef BANKING_POSIX
+            logger.setConsoleOutput(false);
+            
+            string socket_path = (argc > 2) ? argv[2] : BankingDaemon::resolveSocketPath(config);
+            if (BankingDaemon::isListening(socket_path)) {
+                cout << "❌ Another daemon is already listening on " << socket_path << endl;
+                return 1;
+            }
+            BankingSystem bank(&config);
+            BankingDaemon daemon(bank, config, socket_path);
+            cout << "🔌 Daemon listening on " << socket_path << " (Ctrl+C to stop)" << endl;
+            daemon.run();
+            return 0;
+#else
+            cout << "❌ --daemon needs Unix domain sockets, which this platform build does not provide" << endl;
+            return 1;
+#endif
+        }
+        
+        // Concurrency self-check: --stress-test [threads] [transfers per thread] [accounts]
+        if (mode == "--stress-test") {
+            logger.setConsoleOutput(false);
+            
+            TransferStressTest stress_test(config,
+                                           (argc > 2) ? atoi(argv[2]) : 8,
+                                           (argc > 3) ? atoi(argv[3]) : 10000,
+                                           (argc > 4) ? atoi(argv[4]) : 64);
+            TransferStressTest::Result result = stress_test.run();
+            stress_test.printResult(result);
+            return result.conserved() ? 0 : 1;
+        }
+        
+        // Performance regression tracking: --benchmark [results file] [dataset sizes]
+        if (mode == "--benchmark") {
+            logger.setConsoleOutput(false);
+            
+            string output_file = (argc > 2) ? argv[2] : "benchmark_results.json";
+            vector<size_t> sizes = BenchmarkSuite::parseDatasetSizes((argc > 3) ? argv[3] 
+                                                                               : BenchmarkSuite::DEFAULT_DATASET_SIZES);
+            BenchmarkSuite suite(config, sizes);
+            return suite.run(output_file) ? 0 : 1;
+        }
+        
+        // Workload generation: --loadgen [accounts=N] [ops=N] [threads=N] [mix=d:w:t:e] [skew=uniform|zipf]
+        //                                [theta=X] [rate=ops/sec] [seed=N] [report=file.json]
+        if (mode == "--loadgen") {
+            logger.setConsoleOutput(false);
+            
+            LoadGenerator generator(config, LoadGenerator::parseOptions(argc, argv, 2));
+            LoadGenerator::Report report = generator.run();
+            generator.printReport(report);
+            return generator.writeReport(report) ? 0 : 1;
+        }
         
         cout << "\n🎯 System initialized successfully!" << endl;
         cout << "Ready for production deployment with all critical fixes applied." << endl;
         
+        // Records written from the async writer thread would land in the
+        // middle of menu prompts; they still go to the log file
+        if (logger.isAsync()) {
+            logger.setConsoleOutput(false);
+        }
+        
         // FIXED: Create and run the complete banking system
         BankingSystem bank(&config);
         bank.run();